@@ -0,0 +1,138 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for int32_t, int64_t, uint64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"       // for dro::pin_thread, dro::CpuTopology
+#include "dro/batch-exchange.hpp" // for dro::BatchExchange
+#include "dro/spsc-queue.hpp"     // for dro::SPSCQueue
+
+struct Row {
+  std::int64_t id_{};
+  double price_{};
+  std::int32_t quantity_{};
+};
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::size_t batchRows{65'536};
+const std::size_t batchCount{256};
+const std::size_t totalRows{batchRows * batchCount};
+
+Row makeRow(const std::size_t i) {
+  return Row{static_cast<std::int64_t>(i), static_cast<double>(i),
+             static_cast<std::int32_t>(i)};
+}
+
+std::uint64_t rowsPerSecond(const std::chrono::steady_clock::duration time) {
+  return totalRows * 1'000'000'000 /
+         std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+}
+
+std::uint64_t perRow(const int cpu1, const int cpu2) {
+  dro::SPSCQueue<Row> queue(batchRows);
+  std::int64_t sum{};
+  auto thrd = std::thread([&] {
+    dro::pin_thread(cpu1);
+    Row row;
+    for (std::size_t i{}; i < totalRows; ++i) {
+      queue.pop(row);
+      sum += row.quantity_;
+    }
+  });
+
+  dro::pin_thread(cpu2);
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i{}; i < totalRows; ++i) {
+    queue.emplace(makeRow(i));
+  }
+  thrd.join();
+  auto stop = std::chrono::steady_clock::now();
+  if (sum == 0) {
+    throw std::runtime_error("Rows lost");
+  }
+  return rowsPerSecond(stop - start);
+}
+
+std::uint64_t batched(const int cpu1, const int cpu2) {
+  dro::BatchExchange<Row> exchange(4, batchRows);
+  std::int64_t sum{};
+  auto thrd = std::thread([&] {
+    dro::pin_thread(cpu1);
+    for (std::size_t i{}; i < batchCount; ++i) {
+      for (const auto &row : exchange.consume()) {
+        sum += row.quantity_;
+      }
+      exchange.release();
+    }
+  });
+
+  dro::pin_thread(cpu2);
+
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i{}; i < batchCount; ++i) {
+    auto &batch = exchange.acquire();
+    for (std::size_t row{}; row < batchRows; ++row) {
+      batch.push_back(makeRow((i * batchRows) + row));
+    }
+    exchange.publish();
+  }
+  thrd.join();
+  auto stop = std::chrono::steady_clock::now();
+  if (sum == 0) {
+    throw std::runtime_error("Rows lost");
+  }
+  return rowsPerSecond(stop - start);
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+  int cpu2{-1};
+
+  if (argc == 3) {
+    cpu1 = std::stoi(argv[1]);
+    cpu2 = std::stoi(argv[2]);
+  } else if (argc == 1) {
+    const auto pair = dro::CpuTopology().recommend_pair();
+    cpu1 = pair ? pair->first : -1;
+    cpu2 = pair ? pair->second : -1;
+  } else {
+    throw std::invalid_argument(
+        "Provide (2) arguments for the consumer and producer CPU cores.");
+  }
+
+  std::vector<std::uint64_t> rowRate(trialSize);
+  std::vector<std::uint64_t> batchRate(trialSize);
+  for (std::size_t i{}; i < trialSize; ++i) {
+    rowRate[i] = perRow(cpu1, cpu2);
+    batchRate[i] = batched(cpu1, cpu2);
+  }
+  std::sort(rowRate.begin(), rowRate.end());
+  std::sort(batchRate.begin(), batchRate.end());
+
+  std::cout << "dro::SPSCQueue per row emplace: \n";
+  std::cout << "Median: " << rowRate[trialSize / 2] << " rows/s \n";
+  std::cout << "dro::BatchExchange " << batchRows << " row batches: \n";
+  std::cout << "Median: " << batchRate[trialSize / 2] << " rows/s \n";
+
+  return 0;
+}
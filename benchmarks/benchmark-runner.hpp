@@ -0,0 +1,234 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+
+#ifndef DRO_BENCHMARK_RUNNER
+#define DRO_BENCHMARK_RUNNER
+
+#include <algorithm> // for sort, nth_element
+#include <array>     // for array
+#include <chrono>    // for steady_clock, duration_cast, nanoseconds
+#include <cmath>     // for sqrt, abs
+#include <concepts>  // for invocable
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <fstream>   // for ifstream
+#include <iomanip>   // for setprecision
+#include <iostream>  // for ostream, cerr, fixed
+#include <string>    // for string, to_string, getline
+#include <vector>    // for vector
+
+namespace bench {
+
+struct RunnerConfig {
+  // Trials run and discarded before measuring, to warm caches, the allocator,
+  // and the cpu clock
+  std::size_t warmupTrials_{2};
+  std::size_t minTrials_{5};
+  std::size_t maxTrials_{30};
+  // Stop once the 95% confidence interval half width is within this fraction
+  // of the mean. Non-overlapping 1% intervals separate a 3% regression.
+  double targetRelativeCi_{0.01};
+  // A trial is discarded if the calibration loop before or after it ran this
+  // much slower or faster than during warmup, i.e. the core clock changed
+  double maxClockDrift_{0.03};
+};
+
+struct Summary {
+  double mean_{};
+  double median_{};
+  double stddev_{};
+  double ciLow_{};
+  double ciHigh_{};
+  std::size_t trials_{};
+  std::size_t outliers_{};
+  std::size_t drifted_{};
+  bool converged_{};
+};
+
+namespace details {
+
+// Two sided 95% critical values of Student's t for 1 to 30 degrees of freedom
+inline constexpr std::array<double, 30> tCritical{
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+[[nodiscard]] inline double t_critical(const std::size_t degrees) {
+  if (degrees <= tCritical.size()) {
+    return tCritical[degrees - 1];
+  }
+  return (degrees <= 60) ? 2.000 : 1.960;
+}
+
+// Fixed dependent work, so its duration only changes with the core clock
+[[nodiscard]] inline double calibrate_ns() {
+  std::uint64_t val{1};
+  const auto start = std::chrono::steady_clock::now();
+  for (int i{}; i < 1'000'000; ++i) {
+    val = (val * 6'364'136'223'846'793'005) + 1'442'695'040'888'963'407;
+    // Keeps every step in the timed region and out of a closed form
+    asm volatile("" : "+r"(val) : : "memory");
+  }
+  const auto stop = std::chrono::steady_clock::now();
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+          .count());
+}
+
+[[nodiscard]] inline double median(std::vector<double> samples) {
+  const auto middle = samples.begin() + (samples.size() / 2);
+  std::nth_element(samples.begin(), middle, samples.end());
+  return *middle;
+}
+
+// Drops samples outside Tukey's fences of 1.5 interquartile ranges
+[[nodiscard]] inline std::vector<double>
+reject_outliers(std::vector<double> samples) {
+  if (samples.size() < 4) {
+    return samples;
+  }
+  std::sort(samples.begin(), samples.end());
+  const auto q1 = samples[samples.size() / 4];
+  const auto q3 = samples[(3 * samples.size()) / 4];
+  const auto fence = 1.5 * (q3 - q1);
+  std::erase_if(samples, [&](const double sample) {
+    return sample < q1 - fence || sample > q3 + fence;
+  });
+  return samples;
+}
+
+[[nodiscard]] inline Summary summarize(const std::vector<double> &samples) {
+  Summary summary;
+  const auto kept = reject_outliers(samples);
+  const auto count = static_cast<double>(kept.size());
+  summary.trials_ = samples.size();
+  summary.outliers_ = samples.size() - kept.size();
+  for (const auto sample : kept) {
+    summary.mean_ += sample;
+  }
+  summary.mean_ /= count;
+  double squares{};
+  for (const auto sample : kept) {
+    squares += (sample - summary.mean_) * (sample - summary.mean_);
+  }
+  summary.median_ = median(kept);
+  summary.stddev_ = (kept.size() > 1) ? std::sqrt(squares / (count - 1)) : 0.0;
+  const auto halfWidth = (kept.size() > 1)
+                             ? t_critical(kept.size() - 1) * summary.stddev_ /
+                                   std::sqrt(count)
+                             : summary.mean_;
+  summary.ciLow_ = summary.mean_ - halfWidth;
+  summary.ciHigh_ = summary.mean_ + halfWidth;
+  return summary;
+}
+
+} // namespace details
+
+// Warns if the cpu's frequency governor lets the clock scale
+inline void check_governor(const int cpu) {
+  if (cpu < 0) {
+    return;
+  }
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) +
+                     "/cpufreq/scaling_governor");
+  std::string governor;
+  if (file && std::getline(file, governor) && governor != "performance") {
+    std::cerr << "Warning: cpu " << cpu << " uses the " << governor
+              << " governor, results may drift with the clock \n";
+  }
+}
+
+// The mean with its 95% confidence interval, then the median and trial counts
+inline void print(std::ostream &out, const Summary &summary,
+                  const std::string &unit) {
+  if (!summary.trials_) {
+    out << "No trials kept, the clock drifted on every trial \n";
+    return;
+  }
+  const auto flags = out.flags();
+  const auto precision = out.precision();
+  out << std::fixed << std::setprecision(1);
+  out << "Mean: " << summary.mean_ << ' ' << unit << " (stddev "
+      << summary.stddev_ << ", 95% CI " << summary.ciLow_ << " - "
+      << summary.ciHigh_ << ") \n";
+  out << "Median: " << summary.median_ << ' ' << unit << " \n";
+  out << "Trials: " << summary.trials_ << ", outliers rejected "
+      << summary.outliers_ << ", clock drift rejected " << summary.drifted_
+      << (summary.converged_ ? "" : ", CI did not converge") << " \n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+// Repeats a trial until the confidence interval of its mean converges. Each
+// trial returns one measurement and runs between two calibration loops on the
+// calling thread, which should be pinned to a benchmark core.
+class Runner {
+private:
+  RunnerConfig config_;
+
+public:
+  explicit Runner(const RunnerConfig config = RunnerConfig())
+      : config_(config) {}
+
+  template <typename Trial>
+    requires std::invocable<Trial &>
+  [[nodiscard]] Summary run(Trial &&trial) const {
+    std::vector<double> calibration;
+    for (std::size_t i{}; i < config_.warmupTrials_; ++i) {
+      static_cast<void>(trial());
+      calibration.push_back(details::calibrate_ns());
+    }
+    const auto baseline = calibration.empty() ? details::calibrate_ns()
+                                              : details::median(calibration);
+    std::vector<double> samples;
+    std::size_t drifted{};
+    Summary summary;
+    const auto hasDrifted = [&](const double clock) {
+      return std::abs(clock - baseline) > config_.maxClockDrift_ * baseline;
+    };
+    for (std::size_t i{}; i < config_.maxTrials_; ++i) {
+      const auto before = details::calibrate_ns();
+      const auto sample = static_cast<double>(trial());
+      const auto after = details::calibrate_ns();
+      if (hasDrifted(before) || hasDrifted(after)) {
+        ++drifted;
+        continue;
+      }
+      samples.push_back(sample);
+      if (samples.size() < config_.minTrials_) {
+        continue;
+      }
+      summary = details::summarize(samples);
+      if (summary.ciHigh_ - summary.mean_ <=
+          config_.targetRelativeCi_ * std::abs(summary.mean_)) {
+        summary.converged_ = true;
+        break;
+      }
+    }
+    if (!summary.converged_ && !samples.empty()) {
+      summary = details::summarize(samples);
+    }
+    summary.drifted_ = drifted;
+    return summary;
+  }
+
+  template <typename Trial>
+    requires std::invocable<Trial &>
+  void report(std::ostream &out, const std::string &unit,
+              Trial &&trial) const {
+    print(out, run(trial), unit);
+  }
+};
+
+} // namespace bench
+#endif
@@ -0,0 +1,141 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+
+#include <algorithm> // for sort, min
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for uint64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"   // for dro::pin_thread, dro::CpuTopology
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::uint64_t iters{10'000'000};
+const std::size_t queueSize{1'024};
+const std::size_t maxBatch{32};
+
+struct Result {
+  std::uint64_t opsPerSecond_{};
+  // Loads of the peer's index, each a potential cache line transfer
+  std::uint64_t peerLoads_{};
+};
+
+// Both threads size every batch with a capacity query. size() reads both
+// indices on every call, while the lower bounds read the peer's index only
+// when the last observed value leaves nothing to do.
+template <bool LowerBound> Result run(const int cpu1, const int cpu2) {
+  dro::SPSCQueue<std::uint64_t> queue(queueSize);
+  std::uint64_t consumerLoads{};
+  std::uint64_t sum{};
+  auto thrd = std::thread([&] {
+    dro::pin_thread(cpu1);
+    std::uint64_t val{};
+    for (std::uint64_t received{}; received < iters;) {
+      std::size_t ready{};
+      if constexpr (LowerBound) {
+        ready = queue.available_lower_bound();
+        if (!ready) {
+          ready = queue.available_lower_bound(true);
+          ++consumerLoads;
+        }
+      } else {
+        ready = queue.size();
+        ++consumerLoads;
+      }
+      ready = std::min(ready, maxBatch);
+      for (std::size_t i{}; i < ready; ++i) {
+        queue.pop(val);
+        sum += val;
+      }
+      received += ready;
+    }
+  });
+
+  dro::pin_thread(cpu2);
+
+  std::uint64_t producerLoads{};
+  auto start = std::chrono::steady_clock::now();
+  for (std::uint64_t sent{}; sent < iters;) {
+    std::size_t free{};
+    if constexpr (LowerBound) {
+      free = queue.free_slots_lower_bound();
+      if (!free) {
+        free = queue.free_slots_lower_bound(true);
+        ++producerLoads;
+      }
+    } else {
+      free = queue.capacity() - queue.size();
+      ++producerLoads;
+    }
+    free = std::min({free, maxBatch, static_cast<std::size_t>(iters - sent)});
+    for (std::size_t i{}; i < free; ++i) {
+      queue.push(sent++);
+    }
+  }
+  thrd.join();
+  auto stop = std::chrono::steady_clock::now();
+  if (sum != iters * (iters - 1) / 2) {
+    throw std::runtime_error("Elements lost");
+  }
+  return Result{
+      iters * 1'000'000'000 /
+          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+              .count(),
+      producerLoads + consumerLoads};
+}
+
+template <bool LowerBound>
+void report(const char *name, const int cpu1, const int cpu2) {
+  std::vector<Result> results(trialSize);
+  for (auto &result : results) {
+    result = run<LowerBound>(cpu1, cpu2);
+  }
+  std::sort(results.begin(), results.end(),
+            [](const Result &lhs, const Result &rhs) {
+              return lhs.opsPerSecond_ < rhs.opsPerSecond_;
+            });
+  const auto &median = results[trialSize / 2];
+  std::cout << name << ": \n";
+  std::cout << "Median: " << median.opsPerSecond_ << " ops/s, "
+            << median.peerLoads_ * 1'000 / iters
+            << " peer index loads per 1000 ops \n";
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+  int cpu2{-1};
+
+  if (argc == 3) {
+    cpu1 = std::stoi(argv[1]);
+    cpu2 = std::stoi(argv[2]);
+  } else if (argc == 1) {
+    const auto pair = dro::CpuTopology().recommend_pair();
+    cpu1 = pair ? pair->first : -1;
+    cpu2 = pair ? pair->second : -1;
+  } else {
+    throw std::invalid_argument(
+        "Provide (2) arguments for the consumer and producer CPU cores.");
+  }
+
+  report<false>("dro::SPSCQueue size() per batch", cpu1, cpu2);
+  report<true>("dro::SPSCQueue lower bounds per batch", cpu1, cpu2);
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for int64_t, uint64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for runtime_error
+#include <vector>    // for vector
+
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue
+
+// A UI snapshot update, large enough that draining touches real memory
+struct Update {
+  std::int64_t id_{};
+  double values_[7]{};
+};
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::size_t backlog{1'000'000};
+const std::size_t keep{16};
+
+using Queue = dro::SPSCQueue<Update>;
+
+void fill(Queue &queue) {
+  for (std::size_t i{}; i < backlog; ++i) {
+    queue.emplace(Update{static_cast<std::int64_t>(i), {}});
+  }
+}
+
+// Nanoseconds until only the newest keep updates remain
+template <bool Skip> std::uint64_t recover(Queue &queue) {
+  fill(queue);
+  auto start = std::chrono::steady_clock::now();
+  if constexpr (Skip) {
+    static_cast<void>(queue.skip_to_latest(keep));
+  } else {
+    // The backlog is known, so the drain times only the pops, not a size()
+    // per element reading both indexes
+    Update update;
+    for (std::size_t i{}; i < backlog - keep; ++i) {
+      queue.pop(update);
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  Update update;
+  queue.pop(update);
+  if (update.id_ != static_cast<std::int64_t>(backlog - keep)) {
+    throw std::runtime_error("Wrong updates kept");
+  }
+  static_cast<void>(queue.clear());
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+      .count();
+}
+
+template <bool Skip> void report(const char *name) {
+  Queue queue(backlog);
+  std::vector<std::uint64_t> times(trialSize);
+  for (auto &time : times) {
+    time = recover<Skip>(queue);
+  }
+  std::sort(times.begin(), times.end());
+  std::cout << name << ": \n";
+  std::cout << "Median: " << times[trialSize / 2] << " ns to recover from "
+            << backlog << " elements \n";
+}
+
+int main(int argc, char *argv[]) {
+  report<false>("dro::SPSCQueue pop drain");
+  report<true>("dro::SPSCQueue skip_to_latest");
+
+  return 0;
+}
@@ -0,0 +1,177 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort, nth_element
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstddef>   // for ptrdiff_t
+#include <cstdint>   // for int64_t
+#include <cstdio>    // for size_t
+#include <deque>     // for deque
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <mutex>     // for mutex, lock_guard
+#include <stdexcept> // for invalid_argument
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <tuple>     // for tie
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"   // for dro::pin_thread
+#include "dro/dispatcher.hpp" // for dro::Dispatcher, dro::DispatchPolicy
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::size_t iters{1'000'000};
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Tasks per second and the 99th percentile dispatch to start latency in ns
+using Result = std::pair<std::int64_t, std::int64_t>;
+
+Result summarize(std::vector<std::vector<std::int64_t>> &latency,
+                 const std::int64_t elapsedNs) {
+  std::vector<std::int64_t> all;
+  all.reserve(iters);
+  for (const auto &worker : latency) {
+    all.insert(all.end(), worker.begin(), worker.end());
+  }
+  const auto p99 =
+      all.begin() + static_cast<std::ptrdiff_t>(all.size() * 99 / 100);
+  std::nth_element(all.begin(), p99, all.end());
+  return {static_cast<std::int64_t>(iters) * 1'000'000'000 / elapsedNs, *p99};
+}
+
+Result dispatcher(const std::vector<int> &cpus, const std::size_t workers,
+                  const dro::DispatchPolicy policy) {
+  dro::Dispatcher<std::int64_t> dispatcher(workers, 1'024, policy);
+  std::vector<std::vector<std::int64_t>> latency(workers);
+  std::vector<std::thread> threads;
+  for (std::size_t worker{}; worker < workers; ++worker) {
+    latency[worker].reserve(iters);
+    threads.emplace_back([&, worker] {
+      dro::pin_thread(cpus[worker + 1]);
+      auto &inbox = dispatcher.inbox(worker);
+      std::int64_t sent{};
+      while (true) {
+        inbox.pop(sent);
+        if (sent < 0) {
+          break;
+        }
+        latency[worker].push_back(nowNs() - sent);
+      }
+    });
+  }
+
+  const auto start = nowNs();
+  for (std::size_t i{}; i < iters; ++i) {
+    dispatcher.dispatch(nowNs());
+  }
+  for (std::size_t worker{}; worker < workers; ++worker) {
+    dispatcher.inbox(worker).push(-1);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return summarize(latency, nowNs() - start);
+}
+
+Result mutexDeque(const std::vector<int> &cpus, const std::size_t workers) {
+  std::mutex mutex;
+  std::deque<std::int64_t> tasks;
+  std::vector<std::vector<std::int64_t>> latency(workers);
+  std::vector<std::thread> threads;
+  for (std::size_t worker{}; worker < workers; ++worker) {
+    latency[worker].reserve(iters);
+    threads.emplace_back([&, worker] {
+      dro::pin_thread(cpus[worker + 1]);
+      while (true) {
+        std::int64_t sent{};
+        {
+          std::lock_guard lock(mutex);
+          if (tasks.empty()) {
+            continue;
+          }
+          sent = tasks.front();
+          tasks.pop_front();
+        }
+        if (sent < 0) {
+          break;
+        }
+        latency[worker].push_back(nowNs() - sent);
+      }
+    });
+  }
+
+  const auto start = nowNs();
+  for (std::size_t i{}; i < iters; ++i) {
+    std::lock_guard lock(mutex);
+    tasks.push_back(nowNs());
+  }
+  for (std::size_t worker{}; worker < workers; ++worker) {
+    std::lock_guard lock(mutex);
+    tasks.push_back(-1);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return summarize(latency, nowNs() - start);
+}
+
+template <typename Func> void report(const char *name, Func &&func) {
+  std::vector<std::int64_t> throughput(trialSize);
+  std::vector<std::int64_t> p99(trialSize);
+  for (std::size_t i{}; i < trialSize; ++i) {
+    std::tie(throughput[i], p99[i]) = func();
+  }
+  std::sort(throughput.begin(), throughput.end());
+  std::sort(p99.begin(), p99.end());
+  std::cout << name << ": \n";
+  std::cout << "Median: " << throughput[trialSize / 2] << " tasks/s \n";
+  std::cout << "Median: " << p99[trialSize / 2] << " ns p99 latency \n";
+}
+
+// Usage: Dispatcher-Benchmark [workers] [dispatcher cpu, worker cpus...]
+int main(int argc, char *argv[]) {
+  std::size_t workers{2};
+  if (argc >= 2) {
+    workers = static_cast<std::size_t>(std::stoi(argv[1]));
+  }
+  if (!workers) {
+    throw std::invalid_argument("Provide a positive number of workers.");
+  }
+  std::vector<int> cpus(workers + 1, -1);
+  if (argc == static_cast<int>(workers) + 3) {
+    for (std::size_t i{}; i < cpus.size(); ++i) {
+      cpus[i] = std::stoi(argv[i + 2]);
+    }
+  } else if (argc > 2) {
+    throw std::invalid_argument(
+        "Provide a CPU core for the dispatcher and for every worker.");
+  }
+
+  dro::pin_thread(cpus[0]);
+
+  report("dro::Dispatcher (round robin)", [&] {
+    return dispatcher(cpus, workers, dro::DispatchPolicy::RoundRobin);
+  });
+  report("dro::Dispatcher (least loaded)", [&] {
+    return dispatcher(cpus, workers, dro::DispatchPolicy::LeastLoaded);
+  });
+  report("std::mutex + std::deque", [&] { return mutexDeque(cpus, workers); });
+
+  return 0;
+}
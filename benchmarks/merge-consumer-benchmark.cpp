@@ -0,0 +1,108 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for int64_t, uint64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <memory>    // for unique_ptr, make_unique
+#include <random>    // for mt19937_64, uniform_int_distribution
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"       // for dro::pin_thread
+#include "dro/merge-consumer.hpp" // for dro::MergeConsumer
+#include "dro/spsc-queue.hpp"     // for dro::SPSCQueue
+
+struct Event {
+  std::int64_t timestamp_{};
+  std::int64_t payload_{};
+};
+
+struct EventTime {
+  std::int64_t operator()(const Event &event) const noexcept {
+    return event.timestamp_;
+  }
+};
+
+using Queue = dro::SPSCQueue<Event>;
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::size_t events{1'000'000};
+
+// Events per second, with every input filled before the merge starts so only
+// the merge itself is timed
+std::uint64_t merge(const std::size_t inputs) {
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<Queue *> pointers;
+  std::mt19937_64 random(inputs);
+  std::uniform_int_distribution<std::int64_t> gap(1, 100);
+  for (std::size_t i{}; i < inputs; ++i) {
+    queues.push_back(std::make_unique<Queue>(events / inputs));
+    pointers.push_back(queues.back().get());
+    std::int64_t timestamp{};
+    for (std::size_t j{}; j < events / inputs; ++j) {
+      timestamp += gap(random);
+      queues.back()->push(Event{timestamp, static_cast<std::int64_t>(j)});
+    }
+  }
+
+  dro::MergeConsumer<Queue, EventTime> consumer(pointers);
+  const std::size_t total{(events / inputs) * inputs};
+  std::int64_t last{};
+  Event event;
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i{}; i < total; ++i) {
+    // Inputs drain unevenly, so the tail cannot wait for empty inputs
+    if (!consumer.try_pop(event) &&
+        !consumer.pop(event, std::chrono::nanoseconds(0))) {
+      throw std::runtime_error("Events lost");
+    }
+    if (event.timestamp_ < last) {
+      throw std::runtime_error("Events out of order");
+    }
+    last = event.timestamp_;
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return total * 1'000'000'000 /
+         std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+             .count();
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+
+  if (argc == 2) {
+    cpu1 = std::stoi(argv[1]);
+  } else if (argc != 1) {
+    throw std::invalid_argument("Provide (1) argument for CPU core to utilize.");
+  }
+
+  dro::pin_thread(cpu1);
+
+  std::cout << "dro::MergeConsumer throughput: \n";
+  for (std::size_t inputs{2}; inputs <= 16; inputs *= 2) {
+    std::vector<std::uint64_t> throughput(trialSize);
+    for (std::size_t i{}; i < trialSize; ++i) {
+      throughput[i] = merge(inputs);
+    }
+    std::sort(throughput.begin(), throughput.end());
+    std::cout << "Median: " << throughput[trialSize / 2] << " events/s with "
+              << inputs << " inputs \n";
+  }
+
+  return 0;
+}
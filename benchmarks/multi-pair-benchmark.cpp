@@ -0,0 +1,218 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+
+#include <algorithm> // for sort, max, min_element
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for uint64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <latch>     // for latch
+#include <memory>    // for unique_ptr, make_unique
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"   // for dro::CpuTopology, dro::allowed_cpus
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::uint64_t iters{10'000'000};
+const std::uint64_t rttIters{1'000'000};
+// Stack allocated, so the whole queue lives wherever the queue object does
+const std::size_t queueSize{4'096};
+
+using Queue = dro::SPSCQueue<std::uint64_t, queueSize>;
+
+// Two queues per pair, the second carries the round trip replies. Either every
+// queue sits side by side in one allocation, or each has its own.
+class PairQueues {
+private:
+  std::unique_ptr<Queue[]> block_;
+  std::vector<std::unique_ptr<Queue>> separate_;
+  std::vector<Queue *> queues_;
+
+public:
+  PairQueues(const std::size_t pairs, const bool oneAllocation) {
+    if (oneAllocation) {
+      block_ = std::make_unique<Queue[]>(2 * pairs);
+      for (std::size_t i{}; i < 2 * pairs; ++i) {
+        queues_.push_back(&block_[i]);
+      }
+    } else {
+      for (std::size_t i{}; i < 2 * pairs; ++i) {
+        separate_.push_back(std::make_unique<Queue>());
+        queues_.push_back(separate_.back().get());
+      }
+    }
+  }
+
+  Queue &request(const std::size_t pair) { return *queues_[2 * pair]; }
+  Queue &reply(const std::size_t pair) { return *queues_[(2 * pair) + 1]; }
+};
+
+struct PairResult {
+  std::uint64_t opsPerMs_{};
+  std::uint64_t rttNs_{};
+};
+
+struct TrialResult {
+  std::uint64_t aggregateOpsPerMs_{};
+  std::uint64_t minOpsPerMs_{};
+  std::uint64_t medianOpsPerMs_{};
+  std::uint64_t medianRttNs_{};
+};
+
+// One cpu per physical core first, so pairs only share a core once every
+// core is busy. Neighbouring cpus usually share a cache. Only cpus in the
+// process affinity mask are used.
+std::vector<int> orderCpus() {
+  const dro::CpuTopology topology("/sys/devices/system/cpu",
+                                  dro::allowed_cpus());
+  std::vector<int> cpus;
+  std::vector<int> siblings;
+  for (const auto &info : topology.cpus()) {
+    // A sibling only when a lower hyper-thread of its core is also allowed
+    const bool sibling = std::any_of(
+        info.smtSiblings_.begin(), info.smtSiblings_.end(),
+        [&](const int cpu) { return cpu < info.cpu_ && topology.find(cpu); });
+    if (sibling) {
+      siblings.push_back(info.cpu_);
+    } else {
+      cpus.push_back(info.cpu_);
+    }
+  }
+  cpus.insert(cpus.end(), siblings.begin(), siblings.end());
+  return cpus;
+}
+
+int cpuAt(const std::vector<int> &cpus, const std::size_t index) {
+  return (index < cpus.size()) ? cpus[index] : -1;
+}
+
+std::uint64_t elapsedNs(const std::chrono::steady_clock::time_point start,
+                        const std::chrono::steady_clock::time_point stop) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+      .count();
+}
+
+// Every pair streams, then every pair ping pongs, all pairs at once
+TrialResult run(const std::vector<int> &cpus, const std::size_t pairs,
+                const bool oneAllocation) {
+  PairQueues queues(pairs, oneAllocation);
+  std::vector<PairResult> results(pairs);
+  std::latch streamStart(2 * pairs);
+  std::latch rttStart(2 * pairs);
+  std::vector<std::thread> threads;
+  for (std::size_t pair{}; pair < pairs; ++pair) {
+    threads.emplace_back([&, pair] {
+      dro::pin_thread(cpuAt(cpus, 2 * pair));
+      auto &request = queues.request(pair);
+      auto &reply = queues.reply(pair);
+      std::uint64_t val{};
+      streamStart.arrive_and_wait();
+      auto start = std::chrono::steady_clock::now();
+      for (std::uint64_t i{}; i < iters; ++i) {
+        request.emplace(i);
+      }
+      // The consumer acknowledges once it has read the last element
+      reply.pop(val);
+      auto stop = std::chrono::steady_clock::now();
+      results[pair].opsPerMs_ = iters * 1'000'000 / elapsedNs(start, stop);
+
+      rttStart.arrive_and_wait();
+      start = std::chrono::steady_clock::now();
+      for (std::uint64_t i{}; i < rttIters; ++i) {
+        request.emplace(i);
+        reply.pop(val);
+      }
+      stop = std::chrono::steady_clock::now();
+      results[pair].rttNs_ = elapsedNs(start, stop) / rttIters;
+    });
+    threads.emplace_back([&, pair] {
+      dro::pin_thread(cpuAt(cpus, (2 * pair) + 1));
+      auto &request = queues.request(pair);
+      auto &reply = queues.reply(pair);
+      streamStart.arrive_and_wait();
+      std::uint64_t val{};
+      for (std::uint64_t i{}; i < iters; ++i) {
+        request.pop(val);
+        if (val != i) {
+          throw std::runtime_error("Value not equal");
+        }
+      }
+      reply.emplace(val);
+
+      rttStart.arrive_and_wait();
+      for (std::uint64_t i{}; i < rttIters; ++i) {
+        request.pop(val);
+        reply.emplace(val);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  TrialResult trial;
+  std::vector<std::uint64_t> throughput;
+  std::vector<std::uint64_t> rtt;
+  for (const auto &result : results) {
+    trial.aggregateOpsPerMs_ += result.opsPerMs_;
+    throughput.push_back(result.opsPerMs_);
+    rtt.push_back(result.rttNs_);
+  }
+  std::sort(throughput.begin(), throughput.end());
+  std::sort(rtt.begin(), rtt.end());
+  trial.minOpsPerMs_ = throughput.front();
+  trial.medianOpsPerMs_ = throughput[pairs / 2];
+  trial.medianRttNs_ = rtt[pairs / 2];
+  return trial;
+}
+
+// Usage: Multi-Pair-Benchmark [max pairs]
+int main(int argc, char *argv[]) {
+  const auto cpus = orderCpus();
+  std::size_t maxPairs = std::max<std::size_t>(1, cpus.size() / 2);
+  if (argc == 2) {
+    maxPairs = std::stoi(argv[1]);
+  } else if (argc != 1) {
+    throw std::invalid_argument("Provide (1) argument for the maximum pairs.");
+  }
+
+  for (const bool oneAllocation : {false, true}) {
+    std::cout << "dro::SPSCQueue pairs, "
+              << (oneAllocation ? "one allocation" : "separate allocations")
+              << ": \n";
+    for (std::size_t pairs{1}; pairs <= maxPairs; ++pairs) {
+      std::vector<TrialResult> trials(trialSize);
+      for (auto &trial : trials) {
+        trial = run(cpus, pairs, oneAllocation);
+      }
+      std::sort(trials.begin(), trials.end(),
+                [](const TrialResult &lhs, const TrialResult &rhs) {
+                  return lhs.aggregateOpsPerMs_ < rhs.aggregateOpsPerMs_;
+                });
+      const auto &median = trials[trialSize / 2];
+      std::cout << "Pairs: " << pairs
+                << " Median: " << median.aggregateOpsPerMs_
+                << " ops/ms aggregate, per pair " << median.minOpsPerMs_
+                << " min " << median.medianOpsPerMs_ << " median ops/ms, "
+                << median.medianRttNs_ << " ns RTT \n";
+    }
+  }
+
+  return 0;
+}
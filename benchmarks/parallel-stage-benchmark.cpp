@@ -0,0 +1,116 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for uint64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"       // for dro::pin_thread
+#include "dro/parallel-stage.hpp" // for dro::ParallelStage
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::uint64_t iters{200'000};
+const std::size_t maxWorkers{8};
+
+// Stands in for decoding a message, roughly a microsecond of work
+std::uint64_t decode(std::uint64_t val) {
+  for (int i{}; i < 256; ++i) {
+    val ^= val >> 33;
+    val *= 0xff51'afd7'ed55'8ccd;
+  }
+  return val;
+}
+
+// Cores are assigned to the producer, the consumer, then the workers
+int cpuAt(const std::vector<int> &cpus, const std::size_t index) {
+  return (index < cpus.size()) ? cpus[index] : -1;
+}
+
+// Items per second through the stage
+std::uint64_t run(const std::vector<int> &cpus, const std::size_t workers) {
+  dro::ParallelStage<std::uint64_t, std::uint64_t> stage(workers, 1'024);
+  std::vector<std::thread> threads;
+  for (std::size_t worker{}; worker < workers; ++worker) {
+    threads.emplace_back([&, worker] {
+      dro::pin_thread(cpuAt(cpus, worker + 2));
+      auto &inbox = stage.inbox(worker);
+      auto &outbox = stage.outbox(worker);
+      std::uint64_t val{};
+      while (true) {
+        inbox.pop(val);
+        if (val == iters) {
+          break;
+        }
+        // Passes the sequence on, so checking the order costs the consumer
+        // nothing, while the decode result still cannot be optimized away
+        outbox.push(val ^ static_cast<std::uint64_t>(decode(val + 1) == 0));
+      }
+    });
+  }
+  auto producer = std::thread([&] {
+    dro::pin_thread(cpuAt(cpus, 0));
+    for (std::uint64_t i{}; i < iters; ++i) {
+      stage.emplace(i);
+    }
+  });
+
+  dro::pin_thread(cpuAt(cpus, 1));
+  auto start = std::chrono::steady_clock::now();
+  std::uint64_t val{};
+  for (std::uint64_t i{}; i < iters; ++i) {
+    stage.pop(val);
+    if (val != i) {
+      throw std::runtime_error("Output out of order");
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  producer.join();
+  // The producer has finished, so the end markers bypass the round robin
+  for (std::size_t worker{}; worker < workers; ++worker) {
+    stage.inbox(worker).push(iters);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return iters * 1'000'000'000 /
+         std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+             .count();
+}
+
+// Usage: Parallel-Stage-Benchmark [producer, consumer, worker cpus...]
+int main(int argc, char *argv[]) {
+  std::vector<int> cpus;
+  for (int i{1}; i < argc; ++i) {
+    cpus.push_back(std::stoi(argv[i]));
+  }
+
+  std::cout << "dro::ParallelStage scaling: \n";
+  for (std::size_t workers{1}; workers <= maxWorkers; ++workers) {
+    std::vector<std::uint64_t> throughput(trialSize);
+    for (std::size_t i{}; i < trialSize; ++i) {
+      throughput[i] = run(cpus, workers);
+    }
+    std::sort(throughput.begin(), throughput.end());
+    std::cout << "Median: " << throughput[trialSize / 2] << " items/s with "
+              << workers << " workers \n";
+  }
+
+  return 0;
+}
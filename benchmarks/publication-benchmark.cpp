@@ -0,0 +1,162 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for int64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"   // for dro::pin_thread, dro::CpuTopology
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue, dro::SPSCTraits
+
+struct BatchTraits : dro::SPSCTraits {
+  static constexpr std::size_t publish_batch = 16;
+};
+
+struct AdaptiveTraits : BatchTraits {
+  static constexpr bool adaptive_publish = true;
+};
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Median and 99th percentile enqueue to dequeue latency at a light fixed rate
+template <typename Traits>
+std::pair<std::int64_t, std::int64_t> fixedRate(const int cpu1,
+                                                const int cpu2) {
+  const std::size_t queueSize{4'096};
+  const std::size_t iters{100'000};
+  const std::int64_t intervalNs{2'000};
+  std::vector<std::int64_t> median(trialSize);
+  std::vector<std::int64_t> tail(trialSize);
+
+  for (std::size_t i{}; i < trialSize; ++i) {
+    dro::SPSCQueue<std::int64_t, 0, std::allocator<std::int64_t>, Traits> queue(
+        queueSize);
+    std::vector<std::int64_t> latency(iters);
+    auto thrd = std::thread([&]() {
+      dro::pin_thread(cpu1);
+      for (std::size_t i{}; i < iters; ++i) {
+        std::int64_t sent;
+        queue.pop(sent);
+        latency[i] = nowNs() - sent;
+      }
+    });
+
+    dro::pin_thread(cpu2);
+
+    auto next = nowNs();
+    for (std::size_t i{}; i < iters; ++i) {
+      next += intervalNs;
+      while (nowNs() < next) {
+      }
+      queue.emplace(nowNs());
+    }
+    queue.flush();
+    thrd.join();
+
+    std::sort(latency.begin(), latency.end());
+    median[i] = latency[iters / 2];
+    tail[i] = latency[iters * 99 / 100];
+  }
+
+  std::sort(median.begin(), median.end());
+  std::sort(tail.begin(), tail.end());
+  return {median[trialSize / 2], tail[trialSize / 2]};
+}
+
+// Operations per millisecond with the producer never waiting on a timer
+template <typename Traits>
+std::size_t saturation(const int cpu1, const int cpu2) {
+  const std::size_t queueSize{4'096};
+  const std::size_t iters{10'000'000};
+  std::vector<std::size_t> operations(trialSize);
+
+  for (std::size_t i{}; i < trialSize; ++i) {
+    dro::SPSCQueue<int, 0, std::allocator<int>, Traits> queue(queueSize);
+    auto thrd = std::thread([&]() {
+      dro::pin_thread(cpu1);
+      for (std::size_t i{}; i < iters; ++i) {
+        int val;
+        queue.pop(val);
+        if (static_cast<std::size_t>(val) != i) {
+          throw std::runtime_error("Value not equal");
+        }
+      }
+    });
+
+    dro::pin_thread(cpu2);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i{}; i < iters; ++i) {
+      queue.emplace(static_cast<int>(i));
+    }
+    queue.flush();
+    thrd.join();
+    auto stop = std::chrono::steady_clock::now();
+
+    operations[i] =
+        iters * 1'000'000 /
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count();
+  }
+
+  std::sort(operations.begin(), operations.end());
+  return operations[trialSize / 2];
+}
+
+template <typename Traits>
+void report(const char *name, const int cpu1, const int cpu2) {
+  const auto [median, tail] = fixedRate<Traits>(cpu1, cpu2);
+  std::cout << name << ": \n";
+  std::cout << "Median: " << median << " ns latency (fixed rate) \n";
+  std::cout << "Median: " << tail << " ns p99 latency (fixed rate) \n";
+  std::cout << "Median: " << saturation<Traits>(cpu1, cpu2)
+            << " ops/ms (saturation) \n";
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+  int cpu2{-1};
+
+  if (argc == 3) {
+    cpu1 = std::stoi(argv[1]);
+    cpu2 = std::stoi(argv[2]);
+  } else if (argc == 1) {
+    // Defaults to cores sharing a cache but not a physical core
+    if (const auto pair = dro::CpuTopology().recommend_pair()) {
+      cpu1 = pair->first;
+      cpu2 = pair->second;
+    }
+  } else {
+    throw std::invalid_argument(
+        "Provide (2) arguments for CPU cores to utilize.");
+  }
+
+  report<dro::SPSCTraits>("Publish every write", cpu1, cpu2);
+  report<BatchTraits>("Publish batch 16", cpu1, cpu2);
+  report<AdaptiveTraits>("Adaptive publish batch 16", cpu1, cpu2);
+
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for int64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <map>       // for map
+#include <memory>    // for unique_ptr, make_unique
+#include <stdexcept> // for invalid_argument
+#include <string>    // for stoi, basic_string
+#include <utility>   // for move
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"  // for dro::pin_thread, dro::CpuTopology
+#include "dro/reclaimer.hpp" // for dro::Reclaimer
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+const std::size_t iters{20'000};
+
+// Many small nodes, so freeing it walks the whole tree
+using OrderBook = std::map<std::int64_t, std::int64_t>;
+
+std::unique_ptr<OrderBook> makeBook() {
+  auto book = std::make_unique<OrderBook>();
+  for (std::int64_t level{}; level < 1'000; ++level) {
+    book->emplace(level, level);
+  }
+  return book;
+}
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+struct Percentiles {
+  std::int64_t p50_{};
+  std::int64_t p99_{};
+  std::int64_t p999_{};
+};
+
+// Hot thread latency of releasing one order book
+template <typename Release> Percentiles measure(Release &&release) {
+  std::vector<std::int64_t> latency(iters);
+  for (std::size_t i{}; i < iters; ++i) {
+    auto book = makeBook();
+    const auto start = nowNs();
+    release(std::move(book));
+    latency[i] = nowNs() - start;
+  }
+  std::sort(latency.begin(), latency.end());
+  return {latency[iters / 2], latency[iters * 99 / 100],
+          latency[iters * 999 / 1'000]};
+}
+
+void report(const char *name, std::vector<Percentiles> &trials) {
+  auto median = [&](auto member) {
+    std::vector<std::int64_t> values;
+    for (const auto &trial : trials) {
+      values.push_back(trial.*member);
+    }
+    std::sort(values.begin(), values.end());
+    return values[trialSize / 2];
+  };
+  std::cout << name << ": \n";
+  std::cout << "Median: " << median(&Percentiles::p50_) << " ns p50 \n";
+  std::cout << "Median: " << median(&Percentiles::p99_) << " ns p99 \n";
+  std::cout << "Median: " << median(&Percentiles::p999_) << " ns p99.9 \n";
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+  int cpu2{-1};
+
+  if (argc == 3) {
+    cpu1 = std::stoi(argv[1]);
+    cpu2 = std::stoi(argv[2]);
+  } else if (argc == 1) {
+    const auto pair = dro::CpuTopology().recommend_pair();
+    cpu1 = pair ? pair->first : -1;
+    cpu2 = pair ? pair->second : -1;
+  } else {
+    throw std::invalid_argument(
+        "Provide (2) arguments for the hot and reclaimer CPU cores.");
+  }
+
+  dro::pin_thread(cpu1);
+
+  std::vector<Percentiles> inlineTrials(trialSize);
+  std::vector<Percentiles> offloadTrials(trialSize);
+  for (std::size_t i{}; i < trialSize; ++i) {
+    inlineTrials[i] =
+        measure([](std::unique_ptr<OrderBook> book) { book.reset(); });
+    {
+      // The reclaimer thread inherits the affinity of its creator
+      dro::pin_thread(cpu2);
+      dro::Reclaimer reclaimer(1, iters);
+      dro::pin_thread(cpu1);
+      offloadTrials[i] = measure([&](std::unique_ptr<OrderBook> book) {
+        reclaimer.retire(0, std::move(book));
+      });
+    }
+  }
+
+  report("Inline destruction", inlineTrials);
+  report("dro::Reclaimer", offloadTrials);
+
+  return 0;
+}
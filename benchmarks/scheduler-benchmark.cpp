@@ -0,0 +1,144 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <memory>    // for unique_ptr
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"   // for dro::pin_thread
+#include "dro/scheduler.hpp"  // for dro::Scheduler, dro::Stage
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+// A single element circulates around a ring of stages, so every hop waits on
+// the previous one and the time per hop is the hand-off latency
+const std::size_t stageCount{4};
+const std::size_t iters{100'000};
+
+dro::Stage driver(dro::StageQueue<int> &out, dro::StageQueue<int> &in) {
+  for (std::size_t i{}; i < iters; ++i) {
+    co_await dro::push(out, static_cast<int>(i));
+    int val;
+    co_await dro::pop(in, val);
+    if (static_cast<std::size_t>(val) != i) {
+      throw std::runtime_error("Value not equal");
+    }
+  }
+}
+
+dro::Stage forward(dro::StageQueue<int> &in, dro::StageQueue<int> &out) {
+  for (std::size_t i{}; i < iters; ++i) {
+    int val;
+    co_await dro::pop(in, val);
+    co_await dro::push(out, val);
+  }
+}
+
+std::size_t coroutineHop(const int cpu) {
+  dro::pin_thread(cpu);
+  std::vector<std::unique_ptr<dro::StageQueue<int>>> queues;
+  for (std::size_t i{}; i < stageCount; ++i) {
+    queues.push_back(std::make_unique<dro::StageQueue<int>>(1));
+  }
+  dro::Scheduler scheduler;
+  scheduler.spawn(driver(*queues[0], *queues[stageCount - 1]));
+  for (std::size_t i{}; i + 1 < stageCount; ++i) {
+    scheduler.spawn(forward(*queues[i], *queues[i + 1]));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  if (!scheduler.run()) {
+    throw std::runtime_error("Pipeline stalled");
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+             .count() /
+         (iters * stageCount);
+}
+
+std::size_t threadHop(const std::vector<int> &cpus) {
+  std::vector<std::unique_ptr<dro::SPSCQueue<int>>> queues;
+  for (std::size_t i{}; i < stageCount; ++i) {
+    queues.push_back(std::make_unique<dro::SPSCQueue<int>>(1));
+  }
+  std::vector<std::thread> threads;
+  for (std::size_t i{}; i + 1 < stageCount; ++i) {
+    threads.emplace_back([&, i]() {
+      dro::pin_thread(cpus[i + 1]);
+      for (std::size_t j{}; j < iters; ++j) {
+        int val;
+        queues[i]->pop(val);
+        queues[i + 1]->push(val);
+      }
+    });
+  }
+
+  dro::pin_thread(cpus[0]);
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i{}; i < iters; ++i) {
+    queues[0]->push(static_cast<int>(i));
+    int val;
+    queues[stageCount - 1]->pop(val);
+    if (static_cast<std::size_t>(val) != i) {
+      throw std::runtime_error("Value not equal");
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  for (auto &thrd : threads) {
+    thrd.join();
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+             .count() /
+         (iters * stageCount);
+}
+
+int main(int argc, char *argv[]) {
+  // One core for the scheduler, and one per stage for the threads
+  std::vector<int> cpus(stageCount, -1);
+
+  if (argc == stageCount + 1) {
+    for (std::size_t i{}; i < stageCount; ++i) {
+      cpus[i] = std::stoi(argv[i + 1]);
+    }
+  } else if (argc != 1) {
+    throw std::invalid_argument(
+        "Provide (4) arguments for CPU cores to utilize.");
+  }
+
+  std::vector<std::size_t> coroutineTime(trialSize);
+  std::vector<std::size_t> threadTime(trialSize);
+
+  std::cout << "dro::Scheduler: \n";
+
+  for (std::size_t i{}; i < trialSize; ++i) {
+    coroutineTime[i] = coroutineHop(cpus[0]);
+    threadTime[i] = threadHop(cpus);
+  }
+
+  std::sort(coroutineTime.begin(), coroutineTime.end());
+  std::sort(threadTime.begin(), threadTime.end());
+
+  std::cout << "Median: " << coroutineTime[trialSize / 2]
+            << " ns per hop (coroutine stages on one core) \n";
+  std::cout << "Median: " << threadTime[trialSize / 2]
+            << " ns per hop (one thread per stage) \n";
+
+  return 0;
+}
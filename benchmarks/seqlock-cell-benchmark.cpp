@@ -0,0 +1,117 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <atomic>    // for atomic
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"     // for dro::pin_thread, dro::CpuTopology
+#include "dro/seqlock-cell.hpp" // for dro::SeqLockCell
+
+// Price update published by the writer; the invariant lets the reader detect
+// a torn read that slipped through
+struct FairPrice {
+  long bid_;
+  long ask_;
+  long spread_;
+};
+
+std::size_t readLatency(dro::SeqLockCell<FairPrice> &cell, std::size_t iters) {
+  auto start = std::chrono::steady_clock::now();
+  for (std::size_t i{}; i < iters; ++i) {
+    FairPrice val = cell.load();
+    if (val.ask_ - val.bid_ != val.spread_) {
+      throw std::runtime_error("Torn read");
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+             .count() *
+         1'000 / iters;
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+  int cpu2{-1};
+
+  if (argc == 3) {
+    cpu1 = std::stoi(argv[1]);
+    cpu2 = std::stoi(argv[2]);
+  } else if (argc == 1) {
+    // Defaults to cores sharing a cache but not a physical core
+    if (const auto pair = dro::CpuTopology().recommend_pair()) {
+      cpu1 = pair->first;
+      cpu2 = pair->second;
+    }
+  } else {
+    throw std::invalid_argument(
+        "Provide (2) arguments for CPU cores to utilize.");
+  }
+
+  const std::size_t trialSize{5};
+  static_assert(trialSize % 2, "Trial size must be odd");
+
+  const std::size_t iters{10'000'000};
+  std::vector<std::size_t> idleLatency(trialSize);
+  std::vector<std::size_t> busyLatency(trialSize);
+  std::vector<std::size_t> writeRate(trialSize);
+
+  std::cout << "dro::SeqLockCell: \n";
+
+  for (std::size_t i{}; i < trialSize; ++i) {
+    dro::SeqLockCell<FairPrice> cell;
+    dro::pin_thread(cpu2);
+    idleLatency[i] = readLatency(cell, iters);
+
+    std::atomic<bool> done{false};
+    std::size_t writes{};
+    auto thrd = std::thread([&]() {
+      dro::pin_thread(cpu1);
+      long price{};
+      // The writer never waits, so this is the highest possible write rate
+      while (!done.load(std::memory_order_relaxed)) {
+        ++price;
+        cell.store(FairPrice{price, price + 2, 2});
+        ++writes;
+      }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    busyLatency[i] = readLatency(cell, iters);
+    auto stop = std::chrono::steady_clock::now();
+    done.store(true, std::memory_order_relaxed);
+    thrd.join();
+    writeRate[i] =
+        writes * 1'000'000 /
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count();
+  }
+
+  std::sort(idleLatency.begin(), idleLatency.end());
+  std::sort(busyLatency.begin(), busyLatency.end());
+  std::sort(writeRate.begin(), writeRate.end());
+
+  // Latency is reported in picoseconds per read to keep integer precision
+  std::cout << "Median: " << idleLatency[trialSize / 2]
+            << " ps per read (idle writer) \n";
+  std::cout << "Median: " << busyLatency[trialSize / 2]
+            << " ps per read (busy writer) \n";
+  std::cout << "Median: " << writeRate[trialSize / 2] << " writes/ms \n";
+
+  return 0;
+}
@@ -10,21 +10,22 @@
 // The above copyright notice and this permission notice shall be included in
 // all copies or substantial portions of the Software.
 
-#include <algorithm> // for sort
+#include <atomic>    // for atomic
 #include <chrono>    // for duration, duration_cast, operator-, steady_...
-#include <cstdio>    // for size_t, perror
+#include <cstdio>    // for size_t
+#include <cstring>   // for memcpy
 #include <iostream>  // for operator<<, basic_ostream, char_traits, cout
-#include <numeric>   // for accumulate
+#include <numeric>   // for iota
+#include <random>    // for mt19937_64
 #include <stdexcept> // for invalid_argument, runtime_error
 #include <string>    // for stoi, basic_string
 #include <thread>    // for thread
+#include <utility>   // for swap
 #include <vector>    // for vector
 
-#include <pthread.h> // for pthread_self, pthread_setaffinity_np
-#include <sched.h>   // for cpu_set_t, CPU_SET, CPU_ZERO
-#include <stdlib.h>  // for exit
-
-#include "dro/spsc-queue.hpp" // for dro::SPSCQueue
+#include "benchmark-runner.hpp" // for bench::Runner, bench::check_governor
+#include "dro/affinity.hpp"       // for dro::CpuTopology, dro::allowed_cpus
+#include "dro/spsc-queue.hpp"     // for dro::SPSCQueue
 
 #if __has_include(<rigtorp/SPSCQueue.h> )
 #include <rigtorp/SPSCQueue.h>
@@ -42,32 +43,196 @@
 #include <readerwriterqueue/readerwriterqueue.h>
 #endif
 
-void pinThread(int cpu) {
-  if (cpu < 0) {
-    return;
+const std::size_t queueSize{10'000'000};
+const std::size_t iters{10'000'000};
+
+double opsPerMs(const std::chrono::steady_clock::time_point start,
+                const std::chrono::steady_clock::time_point stop) {
+  return static_cast<double>(iters) * 1'000'000 /
+         static_cast<double>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+                 .count());
+}
+
+double rttNs(const std::chrono::steady_clock::time_point start,
+             const std::chrono::steady_clock::time_point stop) {
+  return static_cast<double>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+                 .count()) /
+         static_cast<double>(iters);
+}
+
+// Noisy neighbours that run during every test, e.g. analytics jobs sharing
+// the socket. Each works on its own buffer, sized well past a typical LLC.
+enum class Antagonist { None, Stream, Chase, Thrash };
+
+const std::size_t antagonistBytes{128 * 1024 * 1024};
+
+Antagonist parseAntagonist(const std::string &name) {
+  if (name == "none") {
+    return Antagonist::None;
+  }
+  if (name == "stream") {
+    return Antagonist::Stream;
+  }
+  if (name == "chase") {
+    return Antagonist::Chase;
+  }
+  if (name == "thrash") {
+    return Antagonist::Thrash;
+  }
+  throw std::invalid_argument("Antagonist must be none, stream, chase, or "
+                              "thrash.");
+}
+
+class Antagonists {
+private:
+  std::atomic<bool> stop_{false};
+  std::vector<std::thread> threads_;
+
+public:
+  // One thread pinned to each cpu
+  Antagonists(const Antagonist kind, const std::vector<int> &cpus) {
+    if (kind == Antagonist::None) {
+      return;
+    }
+    for (const int cpu : cpus) {
+      threads_.emplace_back([this, kind, cpu] {
+        dro::pin_thread(cpu);
+        if (kind == Antagonist::Stream) {
+          stream();
+        } else if (kind == Antagonist::Chase) {
+          chase();
+        } else {
+          thrash();
+        }
+      });
+    }
+  }
+
+  ~Antagonists() {
+    stop_.store(true, std::memory_order_relaxed);
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+  }
+  // Non-Copyable and Non-Movable
+  Antagonists(const Antagonists &lhs) = delete;
+  Antagonists &operator=(const Antagonists &lhs) = delete;
+  Antagonists(Antagonists &&lhs) = delete;
+  Antagonists &operator=(Antagonists &&lhs) = delete;
+
+private:
+  // Sequential copies saturate memory bandwidth
+  void stream() {
+    std::vector<char> src(antagonistBytes / 2, 1);
+    std::vector<char> dst(antagonistBytes / 2);
+    while (!stop_.load(std::memory_order_relaxed)) {
+      std::memcpy(dst.data(), src.data(), src.size());
+      std::memcpy(src.data(), dst.data(), dst.size());
+    }
+  }
+
+  // Dependent loads in a random cycle, one cache miss at a time
+  void chase() {
+    std::vector<std::size_t> next(antagonistBytes / sizeof(std::size_t));
+    std::iota(next.begin(), next.end(), 0);
+    // Sattolo's algorithm leaves a single cycle through every element
+    std::mt19937_64 random{42};
+    for (std::size_t i{next.size() - 1}; i > 0; --i) {
+      std::swap(next[i], next[random() % i]);
+    }
+    std::size_t index{};
+    while (!stop_.load(std::memory_order_relaxed)) {
+      for (int i{}; i < 1'024; ++i) {
+        index = next[index];
+      }
+    }
+    volatile std::size_t sink = index;
+    static_cast<void>(sink);
+  }
+
+  // Dirties one line per page so the prefetcher cannot help and every write
+  // evicts a line from the LLC
+  void thrash() {
+    const std::size_t stride{4'096 + 64};
+    std::vector<char> buffer(antagonistBytes);
+    std::size_t offset{};
+    while (!stop_.load(std::memory_order_relaxed)) {
+      for (std::size_t i{offset}; i < buffer.size(); i += stride) {
+        ++buffer[i];
+      }
+      offset = (offset + 64) % stride;
+    }
+    volatile char sink = buffer[0];
+    static_cast<void>(sink);
   }
-  cpu_set_t cpuSet;
-  CPU_ZERO(&cpuSet);
-  CPU_SET(cpu, &cpuSet);
-  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) ==
-      -1) {
-    perror("pthread_setaffinity_np");
-    exit(1);
+};
+
+// Every online cpu except the benchmark cores
+// Online cpus outside the process affinity mask are not usable, e.g. under
+// taskset or a cgroup cpuset
+std::vector<int> otherCpus(const int cpu1, const int cpu2) {
+  std::vector<int> cpus;
+  for (const int cpu : dro::allowed_cpus()) {
+    if (cpu != cpu1 && cpu != cpu2) {
+      cpus.push_back(cpu);
+    }
   }
+  return cpus;
 }
 
+// Usage: SPSC-Queue-Benchmark [cpu1 cpu2 [antagonist [antagonist cpus...]]]
+// The antagonist is none, stream, chase, or thrash and runs on every other
+// allowed cpu unless cpus are given.
 int main(int argc, char *argv[]) {
   int cpu1{-1};
   int cpu2{-1};
+  auto antagonist = Antagonist::None;
+  std::vector<int> antagonistCpus;
 
-  if (argc == 3) {
+  if (argc >= 3) {
     cpu1 = std::stoi(argv[1]);
     cpu2 = std::stoi(argv[2]);
-  } else if (argc != 1) {
+    if (argc >= 4) {
+      antagonist = parseAntagonist(argv[3]);
+    }
+    for (int i{4}; i < argc; ++i) {
+      antagonistCpus.push_back(std::stoi(argv[i]));
+    }
+  } else if (argc == 1) {
+    // Defaults to cores sharing a cache but not a physical core
+    if (const auto pair = dro::CpuTopology().recommend_pair()) {
+      cpu1 = pair->first;
+      cpu2 = pair->second;
+    }
+  } else {
     throw std::invalid_argument(
         "Provide (2) arguments for CPU cores to utilize.");
   }
 
+  // Antagonists sharing a core with the queue threads would measure time
+  // slicing rather than memory interference
+  if (antagonist != Antagonist::None) {
+    if (antagonistCpus.empty()) {
+      antagonistCpus = otherCpus(cpu1, cpu2);
+    }
+    for (const int cpu : antagonistCpus) {
+      if (cpu < 0 || cpu == cpu1 || cpu == cpu2) {
+        throw std::invalid_argument(
+            "Antagonist cores must differ from the benchmark cores.");
+      }
+    }
+    if (antagonistCpus.empty()) {
+      throw std::invalid_argument("No cores are left for the antagonist.");
+    }
+  }
+  const Antagonists antagonists(antagonist, antagonistCpus);
+  if (antagonist != Antagonist::None) {
+    std::cout << "Running with " << argv[3] << " antagonists on "
+              << antagonistCpus.size() << " threads \n\n";
+  }
+
   // Alignas powers of 2 for convenient testing of various sizes
   struct alignas(4) TestSize {
     int x_;
@@ -75,405 +240,289 @@ int main(int argc, char *argv[]) {
     TestSize(int x) : x_(x) {}
   };
 
-  const std::size_t trialSize{5};
-  static_assert(trialSize % 2, "Trial size must be odd");
-
-  const std::size_t queueSize{10'000'000};
-  const std::size_t iters{10'000'000};
-  std::vector<std::size_t> operations(trialSize);
-  std::vector<std::size_t> roundTripTime(trialSize);
+  // Trials repeat until the 95% confidence interval of the mean is within 1%
+  const bench::Runner runner;
+  bench::check_governor(cpu1);
+  bench::check_governor(cpu2);
 
   std::cout << "dro::SPSCQueue: \n";
 
-  for (int i{}; i < trialSize; ++i) {
-    {
-      dro::SPSCQueue<TestSize> queue(queueSize);
-      auto thrd = std::thread([&]() {
-        pinThread(cpu1);
-        for (int i{}; i < iters; ++i) {
-          TestSize val;
-          queue.pop(val);
-          if (val.x_ != i) {
-            throw std::runtime_error("Value not equal");
-          }
-        }
-      });
-
-      pinThread(cpu2);
-
-      auto start = std::chrono::steady_clock::now();
+  runner.report(std::cout, "ops/ms", [&] {
+    dro::SPSCQueue<TestSize> queue(queueSize);
+    auto thrd = std::thread([&]() {
+      dro::pin_thread(cpu1);
       for (int i{}; i < iters; ++i) {
-        queue.emplace(TestSize(i));
+        TestSize val;
+        queue.pop(val);
+        if (val.x_ != i) {
+          throw std::runtime_error("Value not equal");
+        }
       }
-      thrd.join();
-      auto stop = std::chrono::steady_clock::now();
+    });
 
-      operations[i] =
-          iters * 1'000'000 /
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count();
-    }
+    dro::pin_thread(cpu2);
 
-    {
-      dro::SPSCQueue<TestSize> q1(queueSize), q2(queueSize);
-      auto thrd = std::thread([&]() {
-        pinThread(cpu1);
-        for (int i{}; i < iters; ++i) {
-          TestSize val;
-          q1.pop(val);
-          q2.emplace(val);
-        }
-      });
+    auto start = std::chrono::steady_clock::now();
+    for (int i{}; i < iters; ++i) {
+      queue.emplace(TestSize(i));
+    }
+    thrd.join();
+    auto stop = std::chrono::steady_clock::now();
 
-      pinThread(cpu2);
+    return opsPerMs(start, stop);
+  });
 
-      auto start = std::chrono::steady_clock::now();
+  runner.report(std::cout, "ns RTT", [&] {
+    dro::SPSCQueue<TestSize> q1(queueSize), q2(queueSize);
+    auto thrd = std::thread([&]() {
+      dro::pin_thread(cpu1);
       for (int i{}; i < iters; ++i) {
-        q1.emplace(TestSize(i));
         TestSize val;
-        q2.pop(val);
+        q1.pop(val);
+        q2.emplace(val);
       }
-      auto stop = std::chrono::steady_clock::now();
-      thrd.join();
-      roundTripTime[i] =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count() /
-          iters;
-    }
-  }
+    });
 
-  std::sort(operations.begin(), operations.end());
-  std::sort(roundTripTime.begin(), roundTripTime.end());
+    dro::pin_thread(cpu2);
 
-  // The median value is provided for a visual skewness reference. If the mean
-  // and median differ by more than ~5%, then the results are skewed and should
-  // be discarded.
-  std::cout << "Mean: "
-            << std::accumulate(operations.begin(), operations.end(), 0) /
-                   trialSize
-            << " ops/ms \n";
-  std::cout << "Median: " << operations[trialSize / 2] << " ops/ms \n";
-
-  std::cout << "Mean: "
-            << std::accumulate(roundTripTime.begin(), roundTripTime.end(), 0) /
-                   trialSize
-            << " ns RTT \n";
-  std::cout << "Median: " << roundTripTime[trialSize / 2] << " ns RTT \n";
+    auto start = std::chrono::steady_clock::now();
+    for (int i{}; i < iters; ++i) {
+      q1.emplace(TestSize(i));
+      TestSize val;
+      q2.pop(val);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    thrd.join();
+    return rttNs(start, stop);
+  });
 
 #if __has_include(<rigtorp/SPSCQueue.h> )
 
   std::cout << "\nrigtorp::SPSCQueue:\n";
 
-  for (int i{}; i < trialSize; ++i) {
-    {
-      rigtorp::SPSCQueue<TestSize> q(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          while (!q.front())
-            ;
-          if (q.front()->x_ != i) {
-            throw std::runtime_error("");
-          }
-          q.pop();
-        }
-      });
-
-      pinThread(cpu2);
-
-      auto start = std::chrono::steady_clock::now();
+  runner.report(std::cout, "ops/ms", [&] {
+    rigtorp::SPSCQueue<TestSize> q(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        q.emplace(TestSize(i));
-      }
-      t.join();
-      auto stop = std::chrono::steady_clock::now();
-      operations[i] =
-          iters * 1000000 /
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count();
-    }
-
-    {
-      rigtorp::SPSCQueue<TestSize> q1(queueSize), q2(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          while (!q1.front())
-            ;
-          q2.emplace(*(q1.front()));
-          q1.pop();
+        while (!q.front())
+          ;
+        if (q.front()->x_ != i) {
+          throw std::runtime_error("");
         }
-      });
+        q.pop();
+      }
+    });
 
-      pinThread(cpu2);
+    dro::pin_thread(cpu2);
 
-      auto start = std::chrono::steady_clock::now();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      q.emplace(TestSize(i));
+    }
+    t.join();
+    auto stop = std::chrono::steady_clock::now();
+    return opsPerMs(start, stop);
+  });
+
+  runner.report(std::cout, "ns RTT", [&] {
+    rigtorp::SPSCQueue<TestSize> q1(queueSize), q2(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        q1.emplace(TestSize(i));
-        while (!q2.front())
+        while (!q1.front())
           ;
-        q2.pop();
+        q2.emplace(*(q1.front()));
+        q1.pop();
       }
-      auto stop = std::chrono::steady_clock::now();
-      t.join();
-      roundTripTime[i] =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count() /
-          iters;
+    });
+
+    dro::pin_thread(cpu2);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      q1.emplace(TestSize(i));
+      while (!q2.front())
+        ;
+      q2.pop();
     }
-  }
-  std::sort(operations.begin(), operations.end());
-  std::sort(roundTripTime.begin(), roundTripTime.end());
-  std::cout << "Mean: "
-            << std::accumulate(operations.begin(), operations.end(), 0) /
-                   trialSize
-            << " ops/ms \n";
-
-  std::cout << "Median: " << operations[trialSize / 2] << " ops/ms \n";
-  std::cout << "Mean: "
-            << std::accumulate(roundTripTime.begin(), roundTripTime.end(), 0) /
-                   trialSize
-            << " ns RTT \n";
-  std::cout << "Median: " << roundTripTime[trialSize / 2] << " ns RTT \n";
+    auto stop = std::chrono::steady_clock::now();
+    t.join();
+    return rttNs(start, stop);
+  });
 
 #endif
 
 #if __has_include(<boost/lockfree/spsc_queue.hpp> )
   std::cout << "\nboost::lockfree::spsc:\n";
-  for (int i{}; i < trialSize; ++i) {
-    {
-      boost::lockfree::spsc_queue<TestSize> q(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          TestSize val;
-          while (q.pop(&val, 1) != 1)
-            ;
-          if (val.x_ != i) {
-            throw std::runtime_error("");
-          }
-        }
-      });
-
-      pinThread(cpu2);
-
-      auto start = std::chrono::steady_clock::now();
+  runner.report(std::cout, "ops/ms", [&] {
+    boost::lockfree::spsc_queue<TestSize> q(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        while (!q.push(TestSize(i)))
+        TestSize val;
+        while (q.pop(&val, 1) != 1)
           ;
-      }
-      t.join();
-      auto stop = std::chrono::steady_clock::now();
-      operations[i] =
-          iters * 1000000 /
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count();
-    }
-
-    {
-      boost::lockfree::spsc_queue<TestSize> q1(queueSize), q2(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          TestSize val;
-          while (q1.pop(&val, 1) != 1)
-            ;
-          while (!q2.push(val))
-            ;
+        if (val.x_ != i) {
+          throw std::runtime_error("");
         }
-      });
+      }
+    });
 
-      pinThread(cpu2);
+    dro::pin_thread(cpu2);
 
-      auto start = std::chrono::steady_clock::now();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      while (!q.push(TestSize(i)))
+        ;
+    }
+    t.join();
+    auto stop = std::chrono::steady_clock::now();
+    return opsPerMs(start, stop);
+  });
+
+  runner.report(std::cout, "ns RTT", [&] {
+    boost::lockfree::spsc_queue<TestSize> q1(queueSize), q2(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        while (!q1.push(TestSize(i)))
-          ;
         TestSize val;
-        while (q2.pop(&val, 1) != 1)
+        while (q1.pop(&val, 1) != 1)
+          ;
+        while (!q2.push(val))
           ;
       }
-      auto stop = std::chrono::steady_clock::now();
-      t.join();
-      roundTripTime[i] =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count() /
-          iters;
-    }
-  }
+    });
 
-  std::sort(operations.begin(), operations.end());
-  std::sort(roundTripTime.begin(), roundTripTime.end());
-  std::cout << "Mean: "
-            << std::accumulate(operations.begin(), operations.end(), 0) /
-                   trialSize
-            << " ops/ms \n";
-  std::cout << "Median: " << operations[trialSize / 2] << " ops/ms \n";
+    dro::pin_thread(cpu2);
 
-  std::cout << "Mean: "
-            << std::accumulate(roundTripTime.begin(), roundTripTime.end(), 0) /
-                   trialSize
-            << " ns RTT \n";
-  std::cout << "Median: " << roundTripTime[trialSize / 2] << " ns RTT \n";
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      while (!q1.push(TestSize(i)))
+        ;
+      TestSize val;
+      while (q2.pop(&val, 1) != 1)
+        ;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    t.join();
+    return rttNs(start, stop);
+  });
 
 #endif
 
 #if __has_include(<folly/ProducerConsumerQueue.h>)
   std::cout << "\nfolly::ProducerConsumerQueue:\n";
-  for (int i{}; i < trialSize; ++i) {
-    {
-      folly::ProducerConsumerQueue<TestSize> q(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          TestSize val;
-          while (!q.read(val))
-            ;
-          if (val.x_ != i) {
-            throw std::runtime_error("");
-          }
-        }
-      });
-
-      pinThread(cpu2);
-
-      auto start = std::chrono::steady_clock::now();
+  runner.report(std::cout, "ops/ms", [&] {
+    folly::ProducerConsumerQueue<TestSize> q(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        while (!q.write(TestSize(i)))
+        TestSize val;
+        while (!q.read(val))
           ;
-      }
-      t.join();
-      auto stop = std::chrono::steady_clock::now();
-      operations[i] =
-          iters * 1000000 /
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count();
-    }
-
-    {
-      folly::ProducerConsumerQueue<TestSize> q1(queueSize), q2(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          TestSize val;
-          while (!q1.read(val))
-            ;
-          q2.write(val);
+        if (val.x_ != i) {
+          throw std::runtime_error("");
         }
-      });
+      }
+    });
 
-      pinThread(cpu2);
+    dro::pin_thread(cpu2);
 
-      auto start = std::chrono::steady_clock::now();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      while (!q.write(TestSize(i)))
+        ;
+    }
+    t.join();
+    auto stop = std::chrono::steady_clock::now();
+    return opsPerMs(start, stop);
+  });
+
+  runner.report(std::cout, "ns RTT", [&] {
+    folly::ProducerConsumerQueue<TestSize> q1(queueSize), q2(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        while (!q1.write(TestSize(i)))
-          ;
         TestSize val;
-        while (!q2.read(val))
+        while (!q1.read(val))
           ;
+        q2.write(val);
       }
-      auto stop = std::chrono::steady_clock::now();
-      t.join();
-      roundTripTime[i] =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count() /
-          iters;
-    }
-  }
+    });
 
-  std::sort(operations.begin(), operations.end());
-  std::sort(roundTripTime.begin(), roundTripTime.end());
-  std::cout << "Mean: "
-            << std::accumulate(operations.begin(), operations.end(), 0) /
-                   trialSize
-            << " ops/ms \n";
-  std::cout << "Median: " << operations[trialSize / 2] << " ops/ms \n";
+    dro::pin_thread(cpu2);
 
-  std::cout << "Mean: "
-            << std::accumulate(roundTripTime.begin(), roundTripTime.end(), 0) /
-                   trialSize
-            << " ns RTT \n";
-  std::cout << "Median: " << roundTripTime[trialSize / 2] << " ns RTT \n";
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      while (!q1.write(TestSize(i)))
+        ;
+      TestSize val;
+      while (!q2.read(val))
+        ;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    t.join();
+    return rttNs(start, stop);
+  });
 
 #endif
 
 #if __has_include(<readerwriterqueue/readerwriterqueue.h>)
   std::cout << "\nmoodycamel::ReaderWriterQueue\n";
-  for (int i{}; i < trialSize; ++i) {
-    {
-      moodycamel::ReaderWriterQueue<TestSize> q(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          TestSize val;
-          while (!q.peek())
-            ;
-          q.try_dequeue(val);
-          if (val.x_ != i) {
-            throw std::runtime_error("");
-          }
-        }
-      });
-
-      pinThread(cpu2);
-
-      auto start = std::chrono::steady_clock::now();
+  runner.report(std::cout, "ops/ms", [&] {
+    moodycamel::ReaderWriterQueue<TestSize> q(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        q.try_enqueue(TestSize(i));
-      }
-      t.join();
-      auto stop = std::chrono::steady_clock::now();
-      operations[i] =
-          iters * 1000000 /
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count();
-    }
-
-    {
-      moodycamel::ReaderWriterQueue<TestSize> q1(queueSize), q2(queueSize);
-      auto t = std::thread([&] {
-        pinThread(cpu1);
-        for (int i = 0; i < iters; ++i) {
-          TestSize val;
-          while (!q1.peek())
-            ;
-          q1.try_dequeue(val);
-          q2.try_enqueue(val);
+        TestSize val;
+        while (!q.peek())
+          ;
+        q.try_dequeue(val);
+        if (val.x_ != i) {
+          throw std::runtime_error("");
         }
-      });
+      }
+    });
 
-      pinThread(cpu2);
+    dro::pin_thread(cpu2);
 
-      auto start = std::chrono::steady_clock::now();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      q.try_enqueue(TestSize(i));
+    }
+    t.join();
+    auto stop = std::chrono::steady_clock::now();
+    return opsPerMs(start, stop);
+  });
+
+  runner.report(std::cout, "ns RTT", [&] {
+    moodycamel::ReaderWriterQueue<TestSize> q1(queueSize), q2(queueSize);
+    auto t = std::thread([&] {
+      dro::pin_thread(cpu1);
       for (int i = 0; i < iters; ++i) {
-        q1.try_enqueue(TestSize(i));
         TestSize val;
-        while (!q2.peek())
+        while (!q1.peek())
           ;
-        q2.try_dequeue(val);
+        q1.try_dequeue(val);
+        q2.try_enqueue(val);
       }
-      auto stop = std::chrono::steady_clock::now();
-      t.join();
-      roundTripTime[i] =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
-              .count() /
-          iters;
-    }
-  }
+    });
+
+    dro::pin_thread(cpu2);
 
-  std::sort(operations.begin(), operations.end());
-  std::sort(roundTripTime.begin(), roundTripTime.end());
-  std::cout << "Mean: "
-            << std::accumulate(operations.begin(), operations.end(), 0) /
-                   trialSize
-            << " ops/ms \n";
-  std::cout << "Median: " << operations[trialSize / 2] << " ops/ms \n";
-
-  std::cout << "Mean: "
-            << std::accumulate(roundTripTime.begin(), roundTripTime.end(), 0) /
-                   trialSize
-            << " ns RTT \n";
-  std::cout << "Median: " << roundTripTime[trialSize / 2] << " ns RTT \n";
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; ++i) {
+      q1.try_enqueue(TestSize(i));
+      TestSize val;
+      while (!q2.peek())
+        ;
+      q2.try_dequeue(val);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    t.join();
+    return rttNs(start, stop);
+  });
 
 #endif
 
@@ -0,0 +1,122 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"   // for dro::pin_thread, dro::CpuTopology
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue, dro::SPSCTraits
+
+struct YieldTraits : dro::SPSCTraits {
+  static constexpr auto wait_policy = dro::WaitPolicy::Yield;
+};
+
+struct BatchTraits : dro::SPSCTraits {
+  static constexpr std::size_t publish_batch = 16;
+};
+
+struct NoStatsTraits : dro::SPSCTraits {
+  static constexpr bool enable_stats = false;
+};
+
+struct WideAlignTraits : dro::SPSCTraits {
+  static constexpr std::size_t alignment = 128;
+};
+
+struct BatchNoStatsTraits : BatchTraits {
+  static constexpr bool enable_stats = false;
+};
+
+// Median operations per millisecond across the trials
+template <typename Traits>
+std::size_t throughput(const int cpu1, const int cpu2) {
+  const std::size_t trialSize{5};
+  static_assert(trialSize % 2, "Trial size must be odd");
+
+  // Small enough that the producer regularly waits on a full queue
+  const std::size_t queueSize{4'096};
+  const std::size_t iters{10'000'000};
+  std::vector<std::size_t> operations(trialSize);
+
+  for (std::size_t i{}; i < trialSize; ++i) {
+    dro::SPSCQueue<int, 0, std::allocator<int>, Traits> queue(queueSize);
+    auto thrd = std::thread([&]() {
+      dro::pin_thread(cpu1);
+      for (std::size_t i{}; i < iters; ++i) {
+        int val;
+        queue.pop(val);
+        if (static_cast<std::size_t>(val) != i) {
+          throw std::runtime_error("Value not equal");
+        }
+      }
+    });
+
+    dro::pin_thread(cpu2);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i{}; i < iters; ++i) {
+      queue.emplace(static_cast<int>(i));
+    }
+    queue.flush();
+    thrd.join();
+    auto stop = std::chrono::steady_clock::now();
+
+    operations[i] =
+        iters * 1'000'000 /
+        std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+            .count();
+  }
+
+  std::sort(operations.begin(), operations.end());
+  return operations[trialSize / 2];
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+  int cpu2{-1};
+
+  if (argc == 3) {
+    cpu1 = std::stoi(argv[1]);
+    cpu2 = std::stoi(argv[2]);
+  } else if (argc == 1) {
+    // Defaults to cores sharing a cache but not a physical core
+    if (const auto pair = dro::CpuTopology().recommend_pair()) {
+      cpu1 = pair->first;
+      cpu2 = pair->second;
+    }
+  } else {
+    throw std::invalid_argument(
+        "Provide (2) arguments for CPU cores to utilize.");
+  }
+
+  std::cout << "dro::SPSCQueue traits: \n";
+  std::cout << "Median: " << throughput<dro::SPSCTraits>(cpu1, cpu2)
+            << " ops/ms (default) \n";
+  std::cout << "Median: " << throughput<YieldTraits>(cpu1, cpu2)
+            << " ops/ms (yield wait) \n";
+  std::cout << "Median: " << throughput<BatchTraits>(cpu1, cpu2)
+            << " ops/ms (publish batch 16) \n";
+  std::cout << "Median: " << throughput<NoStatsTraits>(cpu1, cpu2)
+            << " ops/ms (stats disabled) \n";
+  std::cout << "Median: " << throughput<WideAlignTraits>(cpu1, cpu2)
+            << " ops/ms (128 byte alignment) \n";
+  std::cout << "Median: " << throughput<BatchNoStatsTraits>(cpu1, cpu2)
+            << " ops/ms (publish batch 16, stats disabled) \n";
+
+  return 0;
+}
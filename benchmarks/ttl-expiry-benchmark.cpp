@@ -0,0 +1,118 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for invalid_argument, runtime_error
+#include <string>    // for stoi, basic_string
+#include <thread>    // for sleep_for
+#include <vector>    // for vector
+
+#include "dro/affinity.hpp"   // for dro::pin_thread
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+
+  if (argc == 2) {
+    cpu1 = std::stoi(argv[1]);
+  } else if (argc != 1) {
+    throw std::invalid_argument("Provide (1) argument for CPU core to utilize.");
+  }
+
+  struct alignas(4) Quote {
+    int x_;
+    Quote() = default;
+    Quote(int x) : x_(x) {}
+  };
+
+  using Clock = std::chrono::steady_clock;
+  struct Traits : dro::SPSCTraits {
+    using clock_type = Clock;
+  };
+  using Queue = dro::SPSCQueue<Quote, 0, std::allocator<Quote>, Traits>;
+
+  const std::size_t trialSize{5};
+  static_assert(trialSize % 2, "Trial size must be odd");
+
+  // A stall leaves a backlog of stale quotes followed by a few fresh ones
+  const std::size_t staleSize{1'000'000};
+  const std::size_t freshSize{1'000};
+  const auto maxAge = std::chrono::milliseconds(1);
+  std::vector<std::size_t> drainTime(trialSize);
+  std::vector<std::size_t> expiryTime(trialSize);
+
+  dro::pin_thread(cpu1);
+
+  auto fill = [&](Queue &queue) {
+    for (std::size_t i{}; i < staleSize; ++i) {
+      queue.emplace(Quote(static_cast<int>(i)));
+    }
+    std::this_thread::sleep_for(maxAge * 5);
+    for (std::size_t i{}; i < freshSize; ++i) {
+      queue.emplace(Quote(static_cast<int>(staleSize + i)));
+    }
+  };
+
+  std::cout << "dro::SPSCQueue catch-up: \n";
+
+  for (std::size_t i{}; i < trialSize; ++i) {
+    {
+      Queue queue(staleSize + freshSize);
+      fill(queue);
+      // Without expiry every stale quote is moved out and discarded
+      auto start = Clock::now();
+      Quote val;
+      std::size_t fresh{};
+      while (queue.try_pop(val)) {
+        fresh += (static_cast<std::size_t>(val.x_) >= staleSize);
+      }
+      auto stop = Clock::now();
+      if (fresh != freshSize) {
+        throw std::runtime_error("Fresh quotes lost");
+      }
+      drainTime[i] =
+          std::chrono::duration_cast<std::chrono::microseconds>(stop - start)
+              .count();
+    }
+
+    {
+      Queue queue(staleSize + freshSize);
+      fill(queue);
+      auto start = Clock::now();
+      Quote val;
+      std::size_t fresh{};
+      while (queue.pop_fresh(val, maxAge)) {
+        ++fresh;
+      }
+      auto stop = Clock::now();
+      if (fresh != freshSize || queue.expired() != staleSize) {
+        throw std::runtime_error("Expiry count incorrect");
+      }
+      expiryTime[i] =
+          std::chrono::duration_cast<std::chrono::microseconds>(stop - start)
+              .count();
+    }
+  }
+
+  std::sort(drainTime.begin(), drainTime.end());
+  std::sort(expiryTime.begin(), expiryTime.end());
+
+  std::cout << "Median: " << drainTime[trialSize / 2]
+            << " us catch-up (try_pop) \n";
+  std::cout << "Median: " << expiryTime[trialSize / 2]
+            << " us catch-up (pop_fresh) \n";
+
+  return 0;
+}
@@ -0,0 +1,133 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <algorithm> // for sort
+#include <chrono>    // for duration, duration_cast, operator-, steady_...
+#include <cstdint>   // for int64_t
+#include <cstdio>    // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for invalid_argument
+#include <string>    // for stoi, basic_string
+#include <thread>    // for thread
+#include <utility>   // for pair
+#include <vector>    // for vector
+
+#include <time.h> // for clock_gettime, CLOCK_THREAD_CPUTIME_ID
+
+#include "dro/affinity.hpp"   // for dro::pin_thread, dro::CpuTopology
+#include "dro/spsc-queue.hpp" // for dro::SPSCQueue, dro::SPSCTraits
+
+struct YieldTraits : dro::SPSCTraits {
+  static constexpr auto wait_policy = dro::WaitPolicy::Yield;
+};
+
+struct AdaptiveTraits : dro::SPSCTraits {
+  static constexpr auto wait_policy = dro::WaitPolicy::Adaptive;
+};
+
+const std::size_t trialSize{5};
+static_assert(trialSize % 2, "Trial size must be odd");
+
+std::int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::int64_t threadCpuNs() {
+  timespec spec{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &spec);
+  return (spec.tv_sec * 1'000'000'000) + spec.tv_nsec;
+}
+
+// Median enqueue to dequeue latency, and the consumer CPU use in percent
+template <typename Traits>
+std::pair<std::int64_t, std::int64_t>
+fixedRate(const int cpu1, const int cpu2, const std::size_t iters,
+          const std::int64_t intervalNs) {
+  std::vector<std::int64_t> median(trialSize);
+  std::vector<std::int64_t> cpuUse(trialSize);
+
+  for (std::size_t i{}; i < trialSize; ++i) {
+    dro::SPSCQueue<std::int64_t, 0, std::allocator<std::int64_t>, Traits> queue(
+        1'024);
+    std::vector<std::int64_t> latency(iters);
+    auto thrd = std::thread([&]() {
+      dro::pin_thread(cpu1);
+      const auto wallStart = nowNs();
+      const auto cpuStart = threadCpuNs();
+      for (std::size_t i{}; i < iters; ++i) {
+        std::int64_t sent;
+        queue.pop(sent);
+        latency[i] = nowNs() - sent;
+      }
+      cpuUse[i] = (threadCpuNs() - cpuStart) * 100 / (nowNs() - wallStart);
+    });
+
+    dro::pin_thread(cpu2);
+
+    auto next = nowNs();
+    for (std::size_t i{}; i < iters; ++i) {
+      next += intervalNs;
+      while (nowNs() < next) {
+      }
+      queue.emplace(nowNs());
+    }
+    thrd.join();
+
+    std::sort(latency.begin(), latency.end());
+    median[i] = latency[iters / 2];
+  }
+
+  std::sort(median.begin(), median.end());
+  std::sort(cpuUse.begin(), cpuUse.end());
+  return {median[trialSize / 2], cpuUse[trialSize / 2]};
+}
+
+template <typename Traits>
+void report(const char *name, const int cpu1, const int cpu2) {
+  std::cout << name << ": \n";
+  // Short gaps are covered by spinning, long gaps are worth parking for
+  const auto [shortLatency, shortCpu] =
+      fixedRate<Traits>(cpu1, cpu2, 20'000, 5'000);
+  std::cout << "Median: " << shortLatency << " ns latency, " << shortCpu
+            << "% consumer CPU (5 us gaps) \n";
+  const auto [longLatency, longCpu] =
+      fixedRate<Traits>(cpu1, cpu2, 1'000, 500'000);
+  std::cout << "Median: " << longLatency << " ns latency, " << longCpu
+            << "% consumer CPU (500 us gaps) \n";
+}
+
+int main(int argc, char *argv[]) {
+  int cpu1{-1};
+  int cpu2{-1};
+
+  if (argc == 3) {
+    cpu1 = std::stoi(argv[1]);
+    cpu2 = std::stoi(argv[2]);
+  } else if (argc == 1) {
+    // Defaults to cores sharing a cache but not a physical core
+    if (const auto pair = dro::CpuTopology().recommend_pair()) {
+      cpu1 = pair->first;
+      cpu2 = pair->second;
+    }
+  } else {
+    throw std::invalid_argument(
+        "Provide (2) arguments for CPU cores to utilize.");
+  }
+
+  report<dro::SPSCTraits>("Spin", cpu1, cpu2);
+  report<YieldTraits>("Yield", cpu1, cpu2);
+  report<AdaptiveTraits>("Adaptive spin then park", cpu1, cpu2);
+
+  return 0;
+}
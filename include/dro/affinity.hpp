@@ -0,0 +1,268 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_AFFINITY
+#define DRO_AFFINITY
+
+#include <algorithm>    // for std::find, std::min_element
+#include <cerrno>       // for errno
+#include <cstddef>      // for size_t
+#include <filesystem>   // for std::filesystem::path, directory_iterator
+#include <fstream>      // for std::ifstream
+#include <optional>     // for std::optional
+#include <stdexcept>    // for std::invalid_argument, std::runtime_error
+#include <string>       // for std::string, stoi, to_string, getline
+#include <system_error> // for std::system_error, std::generic_category
+#include <utility>      // for std::pair
+#include <vector>       // for std::vector
+
+#include <pthread.h> // for pthread_self, pthread_setaffinity_np
+#include <sched.h>   // for cpu_set_t, CPU_SET, CPU_ZERO, sched_getaffinity
+
+namespace dro {
+
+namespace details {
+
+// Parses the kernel cpu list format e.g. "0-3,8,10-11"
+[[nodiscard]] inline std::vector<int> parse_cpu_list(const std::string &list) {
+  std::vector<int> cpus;
+  std::size_t pos{};
+  while (pos < list.size()) {
+    auto end = list.find(',', pos);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    const auto range = list.substr(pos, end - pos);
+    if (!range.empty() && range != "\n") {
+      const auto dash = range.find('-');
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = (dash == std::string::npos)
+                           ? first
+                           : std::stoi(range.substr(dash + 1));
+      if (last < first) {
+        throw std::invalid_argument("Invalid cpu list: " + list);
+      }
+      for (int cpu{first}; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    }
+    pos = end + 1;
+  }
+  return cpus;
+}
+
+[[nodiscard]] inline std::optional<std::string>
+read_line(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::string line;
+  if (!file || !std::getline(file, line)) {
+    return std::nullopt;
+  }
+  return line;
+}
+
+} // namespace details
+
+// Cpus the calling thread may run on, honoring taskset, cgroups and isolcpus
+[[nodiscard]] inline std::vector<int> allowed_cpus() {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet)) {
+    throw std::system_error(errno, std::generic_category(),
+                            "sched_getaffinity");
+  }
+  std::vector<int> cpus;
+  for (int cpu{}; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(static_cast<std::size_t>(cpu), &cpuSet)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+struct CpuInfo {
+  int cpu_{-1};
+  int core_{-1};
+  int package_{-1};
+  int numaNode_{-1};
+  // Lowest cpu sharing the cache, -1 if the cache is not reported
+  int l2Id_{-1};
+  int l3Id_{-1};
+  std::vector<int> smtSiblings_;
+};
+
+// CPU topology read from /sys/devices/system/cpu, limited to the online cpus
+// the process is allowed to run on
+class CpuTopology {
+private:
+  std::vector<CpuInfo> cpus_;
+
+public:
+  explicit CpuTopology(
+      const std::filesystem::path &root = "/sys/devices/system/cpu",
+      const std::vector<int> &allowed = allowed_cpus()) {
+    const auto online = details::read_line(root / "online");
+    if (!online) {
+      throw std::runtime_error("Cannot read " + (root / "online").string());
+    }
+    for (const int cpu : details::parse_cpu_list(*online)) {
+      if (std::find(allowed.begin(), allowed.end(), cpu) == allowed.end()) {
+        continue;
+      }
+      cpus_.push_back(read_cpu(root / ("cpu" + std::to_string(cpu)), cpu));
+    }
+  }
+
+  [[nodiscard]] const std::vector<CpuInfo> &cpus() const noexcept {
+    return cpus_;
+  }
+
+  [[nodiscard]] const CpuInfo *find(const int cpu) const noexcept {
+    for (const auto &info : cpus_) {
+      if (info.cpu_ == cpu) {
+        return &info;
+      }
+    }
+    return nullptr;
+  }
+
+  // Hyper-threads of the same physical core
+  [[nodiscard]] bool share_core(const int lhs, const int rhs) const noexcept {
+    const auto *info = find(lhs);
+    return info && std::find(info->smtSiblings_.begin(),
+                             info->smtSiblings_.end(),
+                             rhs) != info->smtSiblings_.end();
+  }
+
+  [[nodiscard]] bool share_l2(const int lhs, const int rhs) const noexcept {
+    const auto *left = find(lhs);
+    const auto *right = find(rhs);
+    return left && right && left->l2Id_ != -1 && left->l2Id_ == right->l2Id_;
+  }
+
+  [[nodiscard]] bool share_l3(const int lhs, const int rhs) const noexcept {
+    const auto *left = find(lhs);
+    const auto *right = find(rhs);
+    return left && right && left->l3Id_ != -1 && left->l3Id_ == right->l3Id_;
+  }
+
+  // Producer and consumer cores that share the closest cache without sharing
+  // a physical core. Ties prefer higher numbered cores, away from cpu 0 which
+  // usually services interrupts.
+  [[nodiscard]] std::optional<std::pair<int, int>>
+  recommend_pair() const noexcept {
+    std::optional<std::pair<int, int>> best;
+    int bestScore{-1};
+    for (auto lhs = cpus_.rbegin(); lhs != cpus_.rend(); ++lhs) {
+      for (auto rhs = lhs + 1; rhs != cpus_.rend(); ++rhs) {
+        if (share_core(lhs->cpu_, rhs->cpu_)) {
+          continue;
+        }
+        int score{};
+        if (share_l2(lhs->cpu_, rhs->cpu_)) {
+          score = 3;
+        } else if (share_l3(lhs->cpu_, rhs->cpu_)) {
+          score = 2;
+        } else if (lhs->numaNode_ == rhs->numaNode_) {
+          score = 1;
+        }
+        if (score > bestScore) {
+          bestScore = score;
+          best = std::pair{rhs->cpu_, lhs->cpu_};
+        }
+      }
+    }
+    return best;
+  }
+
+private:
+  [[nodiscard]] static CpuInfo read_cpu(const std::filesystem::path &path,
+                                        const int cpu) {
+    CpuInfo info;
+    info.cpu_ = cpu;
+    if (const auto core = details::read_line(path / "topology" / "core_id")) {
+      info.core_ = std::stoi(*core);
+    }
+    if (const auto package =
+            details::read_line(path / "topology" / "physical_package_id")) {
+      info.package_ = std::stoi(*package);
+    }
+    if (const auto siblings =
+            details::read_line(path / "topology" / "thread_siblings_list")) {
+      info.smtSiblings_ = details::parse_cpu_list(*siblings);
+    }
+    std::error_code error;
+    for (const auto &entry :
+         std::filesystem::directory_iterator(path, error)) {
+      const auto name = entry.path().filename().string();
+      // e.g. cpu0/node0 links to the NUMA node
+      if (name.starts_with("node") && name.size() > 4) {
+        info.numaNode_ = std::stoi(name.substr(4));
+      }
+    }
+    for (const auto &entry :
+         std::filesystem::directory_iterator(path / "cache", error)) {
+      const auto level = details::read_line(entry.path() / "level");
+      const auto type = details::read_line(entry.path() / "type");
+      const auto shared = details::read_line(entry.path() / "shared_cpu_list");
+      if (!level || !shared || (type && *type == "Instruction")) {
+        continue;
+      }
+      const auto sharedCpus = details::parse_cpu_list(*shared);
+      if (sharedCpus.empty()) {
+        continue;
+      }
+      const int id = *std::min_element(sharedCpus.begin(), sharedCpus.end());
+      if (*level == "2") {
+        info.l2Id_ = id;
+      } else if (*level == "3") {
+        info.l3Id_ = id;
+      }
+    }
+    return info;
+  }
+};
+
+// Pins the calling thread, a negative cpu leaves the affinity unchanged
+inline void pin_thread(const int cpu) {
+  if (cpu < 0) {
+    return;
+  }
+  if (cpu >= CPU_SETSIZE) {
+    throw std::invalid_argument("CPU " + std::to_string(cpu) +
+                                " exceeds CPU_SETSIZE");
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(static_cast<std::size_t>(cpu), &cpuSet);
+  const int error =
+      pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+  if (error) {
+    throw std::system_error(error, std::generic_category(),
+                            "pthread_setaffinity_np");
+  }
+}
+
+// Requires CAP_SYS_NICE. A spinning SCHED_FIFO thread can starve the core, so
+// only use on isolated cores.
+inline void set_fifo_priority(const int priority) {
+  sched_param param{};
+  param.sched_priority = priority;
+  const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+  if (error) {
+    throw std::system_error(error, std::generic_category(),
+                            "pthread_setschedparam");
+  }
+}
+
+} // namespace dro
+#endif
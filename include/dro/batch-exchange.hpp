@@ -0,0 +1,116 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_BATCH_EXCHANGE
+#define DRO_BATCH_EXCHANGE
+
+#include <cstddef> // for size_t
+#include <memory>  // for std::allocator
+#include <thread>  // for std::this_thread::yield
+#include <vector>  // for std::vector
+
+#include <dro/spsc-queue.hpp> // for dro::SPSCQueue, dro::MonitorSnapshot
+
+namespace dro {
+
+// Ring of pre-allocated batches exchanged between one producer and one
+// consumer. The producer fills a batch in place while the consumer processes
+// another, and each handoff is a single index publish, so rows never pass
+// through the queue one at a time.
+template <details::SPSC_Type T, details::SPSC_Traits Traits = SPSCTraits>
+class BatchExchange {
+public:
+  using Batch = std::vector<T>;
+
+private:
+  SPSCQueue<Batch, 0, std::allocator<Batch>, Traits> queue_;
+  std::size_t rows_;
+
+public:
+  // Every batch reserves rows up front, so filling never allocates unless a
+  // batch grows past rows
+  BatchExchange(const std::size_t batches, const std::size_t rows)
+      : queue_(batches), rows_(rows) {
+    queue_.initialize_slots([this](Batch &batch) { batch.reserve(rows_); });
+  }
+
+  ~BatchExchange() = default;
+  // Non-Copyable and Non-Movable
+  BatchExchange(const BatchExchange &lhs) = delete;
+  BatchExchange &operator=(const BatchExchange &lhs) = delete;
+  BatchExchange(BatchExchange &&lhs) = delete;
+  BatchExchange &operator=(BatchExchange &&lhs) = delete;
+
+  // Producer only. Returns an empty batch to fill, or nullptr while every
+  // batch is with the consumer.
+  [[nodiscard]] Batch *try_acquire() noexcept {
+    auto *batch = queue_.claim();
+    if (batch) {
+      batch->clear();
+    }
+    return batch;
+  }
+
+  // Producer only. Waits for an empty batch following the wait policy.
+  [[nodiscard]] Batch &acquire() noexcept {
+    auto *batch = try_acquire();
+    while (!batch) {
+      backoff();
+      batch = try_acquire();
+    }
+    return *batch;
+  }
+
+  // Producer only. Hands the acquired batch to the consumer, never held back
+  // by Traits::publish_batch.
+  void publish() noexcept {
+    queue_.commit();
+    queue_.flush();
+  }
+
+  // Consumer only. Returns the oldest published batch, or nullptr if none.
+  [[nodiscard]] Batch *try_consume() noexcept { return queue_.front(); }
+
+  // Consumer only. Waits for a published batch following the wait policy.
+  [[nodiscard]] Batch &consume() noexcept {
+    auto *batch = try_consume();
+    while (!batch) {
+      backoff();
+      batch = try_consume();
+    }
+    return *batch;
+  }
+
+  // Consumer only. Returns the consumed batch to the producer for reuse.
+  void release() noexcept { queue_.pop(); }
+
+  [[nodiscard]] std::size_t batches() const noexcept {
+    return queue_.capacity();
+  }
+
+  [[nodiscard]] std::size_t rows() const noexcept { return rows_; }
+
+  // Safe from any thread, each published or released batch is one sequence
+  [[nodiscard]] MonitorSnapshot monitor_snapshot() const noexcept {
+    return queue_.monitor_snapshot();
+  }
+
+private:
+  static void backoff() noexcept {
+    if constexpr (Traits::wait_policy != WaitPolicy::Spin) {
+      std::this_thread::yield();
+    }
+  }
+};
+
+} // namespace dro
+#endif
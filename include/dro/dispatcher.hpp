@@ -0,0 +1,170 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_DISPATCHER
+#define DRO_DISPATCHER
+
+#include <concepts>  // for std::constructible_from
+#include <cstddef>   // for size_t
+#include <memory>    // for std::unique_ptr, std::make_unique, allocator
+#include <stdexcept> // for std::logic_error, std::out_of_range
+#include <utility>   // for std::forward, std::move
+#include <vector>    // for std::vector
+
+#include <dro/spsc-queue.hpp> // for dro::SPSCQueue, dro::SPSCTraits
+
+namespace dro {
+
+// Worker selection of a Dispatcher
+enum class DispatchPolicy {
+  RoundRobin, // Cycles through the workers
+  LeastLoaded // Shallowest inbox, from depths cached by the dispatcher
+};
+
+// Fans tasks out from one dispatch thread to workers, each with a private
+// SPSC inbox. Workers may report back through their own completion queue.
+// Every queue has a single producer, so no worker contends with another.
+template <details::SPSC_Type Task, details::SPSC_Type Result = Task,
+          details::SPSC_Traits Traits = SPSCTraits>
+class Dispatcher {
+public:
+  using InboxQueue = SPSCQueue<Task, 0, std::allocator<Task>, Traits>;
+  using CompletionQueue = SPSCQueue<Result, 0, std::allocator<Result>, Traits>;
+
+private:
+  // Separate allocations keep each queue on its own cache lines
+  std::vector<std::unique_ptr<InboxQueue>> inboxes_;
+  std::vector<std::unique_ptr<CompletionQueue>> completions_;
+  // Tasks dispatched since the last refresh on top of the depth read then,
+  // never below the true depth, so selection reads no worker cache lines
+  std::vector<std::size_t> depths_;
+  DispatchPolicy policy_;
+  std::size_t next_{0};
+
+public:
+  // A zero completionCapacity creates no completion queues
+  Dispatcher(const std::size_t workers, const std::size_t capacity,
+             const DispatchPolicy policy = DispatchPolicy::RoundRobin,
+             const std::size_t completionCapacity = 0)
+      : depths_(workers), policy_(policy) {
+    if (!workers) {
+      throw std::logic_error("Workers must be a positive number");
+    }
+    inboxes_.reserve(workers);
+    for (std::size_t i{}; i < workers; ++i) {
+      inboxes_.push_back(std::make_unique<InboxQueue>(capacity));
+      if (completionCapacity) {
+        completions_.push_back(
+            std::make_unique<CompletionQueue>(completionCapacity));
+      }
+    }
+  }
+
+  ~Dispatcher() = default;
+  // Non-Copyable and Non-Movable
+  Dispatcher(const Dispatcher &lhs) = delete;
+  Dispatcher &operator=(const Dispatcher &lhs) = delete;
+  Dispatcher(Dispatcher &&lhs) = delete;
+  Dispatcher &operator=(Dispatcher &&lhs) = delete;
+
+  // Dispatch thread only. Waits while the selected inbox is full and returns
+  // the worker. A worker blocked on a full completion queue never drains its
+  // inbox, so poll completions or size them for every task in flight.
+  template <typename... Args>
+    requires std::constructible_from<Task, Args &&...>
+  std::size_t dispatch(Args &&...args) {
+    const auto worker = select();
+    inboxes_[worker]->emplace(std::forward<Args>(args)...);
+    ++depths_[worker];
+    return worker;
+  }
+
+  // Dispatch thread only. Returns false if the selected inbox is full, the
+  // next call selects again.
+  template <typename... Args>
+    requires std::constructible_from<Task, Args &&...>
+  [[nodiscard]] bool try_dispatch(Args &&...args) {
+    const auto worker = select();
+    if (!inboxes_[worker]->try_emplace(std::forward<Args>(args)...)) {
+      return false;
+    }
+    ++depths_[worker];
+    return true;
+  }
+
+  // Dispatch thread only. Pops every ready result, calling
+  // func(worker, Result&&), and returns the number popped.
+  template <typename Func> std::size_t poll_completions(Func &&func) {
+    std::size_t count{};
+    Result result;
+    for (std::size_t worker{}; worker < completions_.size(); ++worker) {
+      while (completions_[worker]->try_pop(result)) {
+        func(worker, std::move(result));
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  // The worker is the only consumer of its inbox
+  [[nodiscard]] InboxQueue &inbox(const std::size_t worker) {
+    return *inboxes_.at(worker);
+  }
+
+  // The worker is the only producer of its completion queue
+  [[nodiscard]] CompletionQueue &completions(const std::size_t worker) {
+    if (completions_.empty()) {
+      throw std::logic_error("Dispatcher has no completion queues");
+    }
+    return *completions_.at(worker);
+  }
+
+  [[nodiscard]] std::size_t workers() const noexcept {
+    return inboxes_.size();
+  }
+
+  [[nodiscard]] DispatchPolicy policy() const noexcept { return policy_; }
+
+private:
+  [[nodiscard]] std::size_t select() noexcept {
+    std::size_t worker{next_};
+    if (policy_ == DispatchPolicy::LeastLoaded) {
+      worker = least_loaded();
+      // Cached depths only grow between refreshes, so the true depths are
+      // read once every inbox appears full
+      if (depths_[worker] >= inboxes_[worker]->capacity()) {
+        for (std::size_t i{}; i < inboxes_.size(); ++i) {
+          depths_[i] = inboxes_[i]->size();
+        }
+        worker = least_loaded();
+      }
+    }
+    next_ = (worker + 1 == inboxes_.size()) ? 0 : worker + 1;
+    return worker;
+  }
+
+  // Scans from next_ so ties rotate through the workers
+  [[nodiscard]] std::size_t least_loaded() const noexcept {
+    std::size_t best{next_};
+    std::size_t worker{next_};
+    for (std::size_t i{}; i < inboxes_.size(); ++i) {
+      if (depths_[worker] < depths_[best]) {
+        best = worker;
+      }
+      worker = (worker + 1 == inboxes_.size()) ? 0 : worker + 1;
+    }
+    return best;
+  }
+};
+
+} // namespace dro
+#endif
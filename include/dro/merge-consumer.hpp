@@ -0,0 +1,171 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_MERGE_CONSUMER
+#define DRO_MERGE_CONSUMER
+
+#include <algorithm>   // for std::push_heap, std::pop_heap, std::max
+#include <chrono>      // for steady_clock, duration
+#include <concepts>    // for std::invocable
+#include <cstddef>     // for size_t
+#include <stdexcept>   // for std::logic_error
+#include <type_traits> // for std::invoke_result_t, std::decay_t
+#include <utility>     // for std::move
+#include <vector>      // for std::vector
+
+namespace dro {
+
+// Consumer of several SPSC queues that emits their elements in key order,
+// e.g. market data from many feed handlers in exchange timestamp order. Each
+// input must already be ordered by key. The head of every input is peeked in
+// place and only the emitted element is moved out.
+template <typename Queue, typename KeyFunc>
+  requires std::invocable<KeyFunc &, const typename Queue::value_type &>
+class MergeConsumer {
+public:
+  using value_type = typename Queue::value_type;
+  using key_type =
+      std::decay_t<std::invoke_result_t<KeyFunc &, const value_type &>>;
+
+private:
+  struct Head {
+    key_type key_;
+    std::size_t input_;
+    value_type *val_;
+  };
+
+  std::vector<Queue *> inputs_;
+  KeyFunc key_;
+  // Min heap of the peeked heads, ties go to the lower input
+  std::vector<Head> heap_;
+  // Inputs without a peeked head
+  std::vector<std::size_t> lagging_;
+  // When pop first waited on each lagging input, max once it has a head
+  std::vector<std::chrono::steady_clock::time_point> laggingSince_;
+
+public:
+  explicit MergeConsumer(std::vector<Queue *> inputs, KeyFunc key = KeyFunc())
+      : inputs_(std::move(inputs)), key_(std::move(key)) {
+    if (inputs_.empty()) {
+      throw std::logic_error("Inputs must not be empty");
+    }
+    heap_.reserve(inputs_.size());
+    lagging_.reserve(inputs_.size());
+    laggingSince_.assign(inputs_.size(),
+                         std::chrono::steady_clock::time_point::max());
+    for (std::size_t i{}; i < inputs_.size(); ++i) {
+      lagging_.push_back(i);
+    }
+  }
+
+  ~MergeConsumer() = default;
+  // Non-Copyable and Non-Movable
+  MergeConsumer(const MergeConsumer &lhs) = delete;
+  MergeConsumer &operator=(const MergeConsumer &lhs) = delete;
+  MergeConsumer(MergeConsumer &&lhs) = delete;
+  MergeConsumer &operator=(MergeConsumer &&lhs) = delete;
+
+  // Emits the globally next element, which is only known once every input
+  // has a head. Returns false while any input is empty.
+  [[nodiscard]] bool try_pop(value_type &val) {
+    if (!lagging_.empty() && !peek_lagging()) {
+      return false;
+    }
+    emit(val);
+    return true;
+  }
+
+  // Waits up to maxWait for each empty input, then emits the smallest head
+  // available. The wait is budgeted per input from when it first lagged, so a
+  // silent input delays only the first pop after it empties. An element
+  // arriving later with a smaller key is emitted out of order. Returns false
+  // if every input is still empty.
+  template <typename Rep, typename Period>
+  [[nodiscard]] bool pop(value_type &val,
+                         const std::chrono::duration<Rep, Period> &maxWait) {
+    if (!lagging_.empty() && !peek_lagging()) {
+      const auto now = std::chrono::steady_clock::now();
+      for (const auto input : lagging_) {
+        laggingSince_[input] = std::min(laggingSince_[input], now);
+      }
+      while (!peek_lagging() &&
+             std::chrono::steady_clock::now() < lagging_deadline(maxWait)) {
+      }
+      if (heap_.empty()) {
+        return false;
+      }
+    }
+    emit(val);
+    return true;
+  }
+
+  [[nodiscard]] std::size_t inputs() const noexcept { return inputs_.size(); }
+
+private:
+  static bool greater(const Head &lhs, const Head &rhs) noexcept {
+    return (lhs.key_ == rhs.key_) ? lhs.input_ > rhs.input_
+                                  : rhs.key_ < lhs.key_;
+  }
+
+  // The latest budget among the inputs still lagging
+  template <typename Rep, typename Period>
+  std::chrono::steady_clock::time_point
+  lagging_deadline(const std::chrono::duration<Rep, Period> &maxWait) const {
+    auto deadline = std::chrono::steady_clock::time_point::min();
+    for (const auto input : lagging_) {
+      deadline = std::max(
+          deadline,
+          laggingSince_[input] +
+              std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                  maxWait));
+    }
+    return deadline;
+  }
+
+  // Returns true once every input has a head
+  bool peek_lagging() {
+    for (std::size_t i{}; i < lagging_.size();) {
+      if (!peek(lagging_[i])) {
+        ++i;
+        continue;
+      }
+      lagging_[i] = lagging_.back();
+      lagging_.pop_back();
+    }
+    return lagging_.empty();
+  }
+
+  bool peek(const std::size_t input) {
+    auto *head = inputs_[input]->front();
+    if (!head) {
+      return false;
+    }
+    laggingSince_[input] = std::chrono::steady_clock::time_point::max();
+    heap_.push_back(Head{key_(*head), input, head});
+    std::push_heap(heap_.begin(), heap_.end(), greater);
+    return true;
+  }
+
+  void emit(value_type &val) {
+    std::pop_heap(heap_.begin(), heap_.end(), greater);
+    const auto input = heap_.back().input_;
+    val = std::move(*heap_.back().val_);
+    heap_.pop_back();
+    inputs_[input]->pop();
+    if (!peek(input)) {
+      lagging_.push_back(input);
+    }
+  }
+};
+
+} // namespace dro
+#endif
@@ -0,0 +1,287 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_METRICS_REGISTRY
+#define DRO_METRICS_REGISTRY
+
+#include <algorithm>    // for std::min
+#include <atomic>       // for atomic, memory_order
+#include <cerrno>       // for errno
+#include <chrono>       // for steady_clock
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t
+#include <cstring>      // for memcpy
+#include <new>          // for placement new
+#include <stdexcept>    // for std::runtime_error, std::overflow_error
+#include <string>       // for std::string
+#include <string_view>  // for std::string_view
+#include <system_error> // for std::system_error, std::generic_category
+#include <utility>      // for std::move
+
+#include <fcntl.h>    // for O_CREAT, O_RDWR, O_RDONLY
+#include <sys/mman.h> // for shm_open, shm_unlink, mmap, munmap
+#include <unistd.h>   // for ftruncate, close
+
+#include <dro/spsc-queue.hpp> // for dro::details::MonitorCacheLine
+
+namespace dro {
+
+namespace details {
+
+// ASCII "DROSPSC1" identifies a registry segment
+static constexpr std::uint64_t METRICS_MAGIC = 0x3143'5350'534f'5244;
+static constexpr std::size_t METRICS_NAME_SIZE = 48;
+
+struct alignas(cacheLineSize) MetricsHeader {
+  std::uint64_t magic_{METRICS_MAGIC};
+  std::uint64_t slotCount_{};
+  std::uint64_t slotSize_{};
+};
+
+struct alignas(cacheLineSize) MetricsSlot {
+  std::atomic<std::uint32_t> inUse_{0};
+  char name_[METRICS_NAME_SIZE]{};
+  std::uint64_t capacity_{};
+  MonitorCacheLine writer_;
+  MonitorCacheLine reader_;
+};
+
+// Cross process atomics must not depend on the address they are mapped at
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+[[nodiscard]] inline std::size_t metrics_bytes(const std::size_t slots) {
+  return sizeof(MetricsHeader) + (slots * sizeof(MetricsSlot));
+}
+
+template <typename Queue> void detach_queue_monitor(void *queue) noexcept {
+  static_cast<Queue *>(queue)->detach_monitor();
+}
+
+} // namespace details
+
+// Detaches the queue from its registry slot and frees the slot on
+// destruction. Destroy it before the registered queue, and only after the
+// producer and consumer have stopped.
+class MetricsRegistration {
+private:
+  details::MetricsSlot *slot_{nullptr};
+  void *queue_{nullptr};
+  void (*detach_)(void *){nullptr};
+
+public:
+  MetricsRegistration() = default;
+  MetricsRegistration(details::MetricsSlot *slot, void *queue,
+                      void (*detach)(void *)) noexcept
+      : slot_(slot), queue_(queue), detach_(detach) {}
+
+  ~MetricsRegistration() { release(); }
+  // Non-Copyable and Movable
+  MetricsRegistration(const MetricsRegistration &lhs) = delete;
+  MetricsRegistration &operator=(const MetricsRegistration &lhs) = delete;
+  MetricsRegistration(MetricsRegistration &&lhs) noexcept
+      : slot_(lhs.slot_), queue_(lhs.queue_), detach_(lhs.detach_) {
+    lhs.slot_ = nullptr;
+  }
+  MetricsRegistration &operator=(MetricsRegistration &&lhs) noexcept {
+    if (this != &lhs) {
+      release();
+      slot_ = lhs.slot_;
+      queue_ = lhs.queue_;
+      detach_ = lhs.detach_;
+      lhs.slot_ = nullptr;
+    }
+    return *this;
+  }
+
+private:
+  // The queue stops writing to the slot before another queue may claim it
+  void release() noexcept {
+    if (slot_) {
+      detach_(queue_);
+      slot_->inUse_.store(0, std::memory_order_release);
+      slot_ = nullptr;
+    }
+  }
+};
+
+// Owns a POSIX shared memory segment of queue statistics. Queues opt in with
+// add(), after which their cold monitor cache lines live in the segment and
+// can be read by another process e.g. spsc-top.
+//
+// The segment is created exclusively, an existing name throws rather than
+// being truncated under another process. Pass reclaimStale to unlink a
+// segment left behind by a crashed process first.
+class MetricsRegistry {
+private:
+  std::string name_;
+  std::size_t bytes_{};
+  details::MetricsHeader *header_{nullptr};
+  details::MetricsSlot *slots_{nullptr};
+
+public:
+  explicit MetricsRegistry(std::string name, const std::size_t slots = 64,
+                           const bool reclaimStale = false)
+      : name_(std::move(name)), bytes_(details::metrics_bytes(slots)) {
+    if (!slots) {
+      throw std::logic_error("Slots must be a positive number");
+    }
+    if (reclaimStale) {
+      shm_unlink(name_.c_str());
+    }
+    const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), "shm_open");
+    }
+    if (ftruncate(fd, static_cast<off_t>(bytes_)) == -1) {
+      const int error = errno;
+      close(fd);
+      shm_unlink(name_.c_str());
+      throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+    void *memory =
+        mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+      shm_unlink(name_.c_str());
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    header_ = new (memory) details::MetricsHeader{
+        details::METRICS_MAGIC, slots, sizeof(details::MetricsSlot)};
+    slots_ = reinterpret_cast<details::MetricsSlot *>(
+        static_cast<char *>(memory) + sizeof(details::MetricsHeader));
+    for (std::size_t i{}; i < slots; ++i) {
+      new (slots_ + i) details::MetricsSlot{};
+    }
+  }
+
+  ~MetricsRegistry() {
+    munmap(header_, bytes_);
+    shm_unlink(name_.c_str());
+  }
+  // Non-Copyable and Non-Movable
+  MetricsRegistry(const MetricsRegistry &lhs) = delete;
+  MetricsRegistry &operator=(const MetricsRegistry &lhs) = delete;
+  MetricsRegistry(MetricsRegistry &&lhs) = delete;
+  MetricsRegistry &operator=(MetricsRegistry &&lhs) = delete;
+
+  // Not thread safe with respect to the queue, register before the producer
+  // and consumer start
+  template <typename Queue>
+  [[nodiscard]] MetricsRegistration add(std::string_view name, Queue &queue) {
+    for (std::size_t i{}; i < header_->slotCount_; ++i) {
+      auto &slot = slots_[i];
+      std::uint32_t expected{0};
+      if (slot.inUse_.load(std::memory_order_relaxed) ||
+          !slot.inUse_.compare_exchange_strong(expected, 1,
+                                               std::memory_order_acq_rel)) {
+        continue;
+      }
+      const auto length =
+          std::min(name.size(), details::METRICS_NAME_SIZE - 1);
+      std::memcpy(slot.name_, name.data(), length);
+      slot.name_[length] = '\0';
+      slot.capacity_ = queue.capacity();
+      queue.attach_monitor(slot.writer_, slot.reader_);
+      // Publishes the name and capacity to readers of the segment
+      slot.inUse_.store(2, std::memory_order_release);
+      return MetricsRegistration(&slot, &queue,
+                                 &details::detach_queue_monitor<Queue>);
+    }
+    throw std::overflow_error("Metrics registry is full");
+  }
+
+  [[nodiscard]] const std::string &name() const noexcept { return name_; }
+};
+
+// Read only view of a registry segment created by another process
+class MetricsReader {
+private:
+  std::size_t bytes_{};
+  const details::MetricsHeader *header_{nullptr};
+  const details::MetricsSlot *slots_{nullptr};
+
+public:
+  struct QueueMetrics {
+    std::string name_;
+    std::uint64_t capacity_{};
+    MonitorSnapshot snapshot_{};
+  };
+
+  explicit MetricsReader(const std::string &name) {
+    const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), "shm_open");
+    }
+    // Maps the header first to learn the number of slots
+    void *memory =
+        mmap(nullptr, sizeof(details::MetricsHeader), PROT_READ, MAP_SHARED,
+             fd, 0);
+    if (memory == MAP_FAILED) {
+      close(fd);
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    const auto header = *static_cast<const details::MetricsHeader *>(memory);
+    munmap(memory, sizeof(details::MetricsHeader));
+    if (header.magic_ != details::METRICS_MAGIC ||
+        header.slotSize_ != sizeof(details::MetricsSlot)) {
+      close(fd);
+      throw std::runtime_error("Shared memory is not a metrics registry");
+    }
+    bytes_ = details::metrics_bytes(header.slotCount_);
+    memory = mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    header_ = static_cast<const details::MetricsHeader *>(memory);
+    slots_ = reinterpret_cast<const details::MetricsSlot *>(
+        static_cast<const char *>(memory) + sizeof(details::MetricsHeader));
+  }
+
+  ~MetricsReader() {
+    munmap(const_cast<details::MetricsHeader *>(header_), bytes_);
+  }
+  // Non-Copyable and Non-Movable
+  MetricsReader(const MetricsReader &lhs) = delete;
+  MetricsReader &operator=(const MetricsReader &lhs) = delete;
+  MetricsReader(MetricsReader &&lhs) = delete;
+  MetricsReader &operator=(MetricsReader &&lhs) = delete;
+
+  // Calls func(const QueueMetrics&) for every registered queue
+  template <typename Func> void for_each(Func &&func) const {
+    QueueMetrics metrics;
+    for (std::size_t i{}; i < header_->slotCount_; ++i) {
+      const auto &slot = slots_[i];
+      if (slot.inUse_.load(std::memory_order_acquire) != 2) {
+        continue;
+      }
+      metrics.name_ = slot.name_;
+      metrics.capacity_ = slot.capacity_;
+      metrics.snapshot_.writeSequence_ =
+          slot.writer_.sequence_.load(std::memory_order_relaxed);
+      metrics.snapshot_.readSequence_ =
+          slot.reader_.sequence_.load(std::memory_order_relaxed);
+      metrics.snapshot_.fullStalls_ =
+          slot.writer_.stalls_.load(std::memory_order_relaxed);
+      metrics.snapshot_.emptyStalls_ =
+          slot.reader_.stalls_.load(std::memory_order_relaxed);
+      metrics.snapshot_.dropped_ =
+          slot.writer_.dropped_.load(std::memory_order_relaxed);
+      metrics.snapshot_.time_ = std::chrono::steady_clock::now();
+      func(metrics);
+    }
+  }
+};
+
+} // namespace dro
+#endif
@@ -0,0 +1,164 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_PARALLEL_STAGE
+#define DRO_PARALLEL_STAGE
+
+#include <concepts>  // for std::constructible_from
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <memory>    // for std::unique_ptr, std::make_unique, allocator
+#include <stdexcept> // for std::logic_error
+#include <thread>    // for std::this_thread::yield
+#include <utility>   // for std::forward, std::move
+#include <vector>    // for std::vector
+
+#include <dro/spsc-queue.hpp> // for dro::SPSCQueue, dro::SPSCTraits
+
+namespace dro {
+
+// Fans one pipeline stage out to N workers while preserving the input order.
+// Inputs are dealt round robin, so the k-th output of worker w is always item
+// w + k * N and no sequence number travels through the queues. Each worker
+// must push exactly one output per input.
+//
+// Three sides, each a single thread: the producer calls emplace, worker w
+// pops inbox(w) and pushes outbox(w), and the consumer calls pop.
+template <details::SPSC_Type In, details::SPSC_Type Out,
+          details::SPSC_Traits Traits = SPSCTraits>
+class ParallelStage {
+public:
+  using InboxQueue = SPSCQueue<In, 0, std::allocator<In>, Traits>;
+  using OutboxQueue = SPSCQueue<Out, 0, std::allocator<Out>, Traits>;
+
+private:
+  std::vector<std::unique_ptr<InboxQueue>> inboxes_;
+  std::vector<std::unique_ptr<OutboxQueue>> outboxes_;
+  // Producer side, the worker of the next input
+  std::size_t nextInbox_{0};
+
+  // Consumer side. Outputs that arrive ahead of a slow worker wait in the
+  // reorder buffer, at most window sequences past the next one
+  std::vector<Out> buffer_;
+  std::vector<std::uint64_t> nextFrom_;
+  std::uint64_t nextSeq_{0};
+  std::size_t nextOutbox_{0};
+  std::size_t head_{0};
+
+public:
+  // A zero window defaults to workers * capacity
+  ParallelStage(const std::size_t workers, const std::size_t capacity,
+                const std::size_t window = 0)
+      : buffer_(window ? window : workers * capacity), nextFrom_(workers) {
+    if (!workers) {
+      throw std::logic_error("Workers must be a positive number");
+    }
+    inboxes_.reserve(workers);
+    outboxes_.reserve(workers);
+    for (std::size_t i{}; i < workers; ++i) {
+      inboxes_.push_back(std::make_unique<InboxQueue>(capacity));
+      outboxes_.push_back(std::make_unique<OutboxQueue>(capacity));
+      nextFrom_[i] = i;
+    }
+  }
+
+  ~ParallelStage() = default;
+  // Non-Copyable and Non-Movable
+  ParallelStage(const ParallelStage &lhs) = delete;
+  ParallelStage &operator=(const ParallelStage &lhs) = delete;
+  ParallelStage(ParallelStage &&lhs) = delete;
+  ParallelStage &operator=(ParallelStage &&lhs) = delete;
+
+  // Producer only. Waits while the next worker's inbox is full.
+  template <typename... Args>
+    requires std::constructible_from<In, Args &&...>
+  void emplace(Args &&...args) {
+    inboxes_[nextInbox_]->emplace(std::forward<Args>(args)...);
+    advance(nextInbox_);
+  }
+
+  // Producer only. Fails without moving on to another worker, which would
+  // break the round robin order.
+  template <typename... Args>
+    requires std::constructible_from<In, Args &&...>
+  [[nodiscard]] bool try_emplace(Args &&...args) {
+    if (!inboxes_[nextInbox_]->try_emplace(std::forward<Args>(args)...)) {
+      return false;
+    }
+    advance(nextInbox_);
+    return true;
+  }
+
+  // Consumer only. Returns the next output in input order, or false if it is
+  // not ready. Meanwhile ready outputs of other workers move into the reorder
+  // buffer, so a slow worker never stalls the others on a full outbox.
+  [[nodiscard]] bool try_pop(Out &val) {
+    if (nextFrom_[nextOutbox_] == nextSeq_) {
+      if (!outboxes_[nextOutbox_]->try_pop(val)) {
+        fill_buffer();
+        return false;
+      }
+      nextFrom_[nextOutbox_] += outboxes_.size();
+    } else {
+      // Only buffered outputs are behind their worker's next sequence
+      val = std::move(buffer_[head_]);
+    }
+    ++nextSeq_;
+    advance(nextOutbox_);
+    head_ = (head_ + 1 == buffer_.size()) ? 0 : head_ + 1;
+    return true;
+  }
+
+  // Consumer only. Waits for the next output following the wait policy.
+  void pop(Out &val) {
+    while (!try_pop(val)) {
+      if constexpr (Traits::wait_policy != WaitPolicy::Spin) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  // Worker w is the only consumer of its inbox
+  [[nodiscard]] InboxQueue &inbox(const std::size_t worker) {
+    return *inboxes_.at(worker);
+  }
+
+  // Worker w is the only producer of its outbox
+  [[nodiscard]] OutboxQueue &outbox(const std::size_t worker) {
+    return *outboxes_.at(worker);
+  }
+
+  [[nodiscard]] std::size_t workers() const noexcept {
+    return inboxes_.size();
+  }
+
+  [[nodiscard]] std::size_t window() const noexcept { return buffer_.size(); }
+
+private:
+  void advance(std::size_t &worker) const noexcept {
+    worker = (worker + 1 == inboxes_.size()) ? 0 : worker + 1;
+  }
+
+  void fill_buffer() {
+    const auto limit = nextSeq_ + buffer_.size();
+    for (std::size_t worker{}; worker < outboxes_.size(); ++worker) {
+      auto &seq = nextFrom_[worker];
+      while (seq < limit &&
+             outboxes_[worker]->try_pop(buffer_[seq % buffer_.size()])) {
+        seq += outboxes_.size();
+      }
+    }
+  }
+};
+
+} // namespace dro
+#endif
@@ -0,0 +1,170 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_RECLAIMER
+#define DRO_RECLAIMER
+
+#include <array>              // for std::array
+#include <atomic>             // for atomic, memory_order
+#include <chrono>             // for steady_clock, microseconds
+#include <condition_variable> // for std::condition_variable
+#include <cstddef>            // for size_t
+#include <cstdint>            // for uint64_t
+#include <memory>             // for std::unique_ptr, std::default_delete
+#include <mutex>              // for std::mutex, std::unique_lock
+#include <stdexcept>          // for std::logic_error
+#include <thread>             // for std::thread
+#include <vector>             // for std::vector
+
+#include <dro/spsc-queue.hpp> // for dro::SPSCQueue
+
+namespace dro {
+
+namespace details {
+
+// Type erased ownership of an object awaiting destruction
+struct Retired {
+  void *ptr_{nullptr};
+  void (*deleter_)(void *){nullptr};
+};
+
+template <typename T> void delete_retired(void *ptr) noexcept {
+  std::default_delete<T>{}(
+      static_cast<typename std::unique_ptr<T>::pointer>(ptr));
+}
+
+// Objects destroyed per publish of a retire queue's read index
+static constexpr std::size_t RECLAIM_BATCH = 64;
+
+} // namespace details
+
+// Moves the destruction of large objects off hot threads. Each hot thread
+// retires objects into its own SPSC queue and a background thread destroys
+// them in batches, sleeping between passes while the queues are empty.
+class Reclaimer {
+public:
+  using RetireQueue = SPSCQueue<details::Retired>;
+
+private:
+  std::vector<std::unique_ptr<RetireQueue>> queues_;
+  std::chrono::microseconds interval_;
+  std::atomic<std::uint64_t> reclaimed_{0};
+  std::atomic<std::uint64_t> inlineDeletes_{0};
+  // Only the reclaimer thread and the destructor use these
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stop_{false};
+  std::thread thread_;
+
+public:
+  // One retire queue per hot thread. The reclaimer thread sleeps for
+  // interval after a pass that found every queue empty.
+  Reclaimer(const std::size_t threads, const std::size_t capacity,
+            const std::chrono::microseconds interval =
+                std::chrono::microseconds(100))
+      : interval_(interval) {
+    if (!threads) {
+      throw std::logic_error("Threads must be a positive number");
+    }
+    queues_.reserve(threads);
+    for (std::size_t i{}; i < threads; ++i) {
+      queues_.push_back(std::make_unique<RetireQueue>(capacity));
+    }
+    thread_ = std::thread([this] { run(); });
+  }
+
+  // Destroys every retired object, the hot threads must have stopped retiring
+  ~Reclaimer() {
+    {
+      std::lock_guard lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+  }
+  // Non-Copyable and Non-Movable
+  Reclaimer(const Reclaimer &lhs) = delete;
+  Reclaimer &operator=(const Reclaimer &lhs) = delete;
+  Reclaimer(Reclaimer &&lhs) = delete;
+  Reclaimer &operator=(Reclaimer &&lhs) = delete;
+
+  // Called only by the hot thread owning the slot. A full retire queue never
+  // blocks the hot thread, the object is destroyed inline instead.
+  template <typename T>
+  void retire(const std::size_t slot, std::unique_ptr<T> ptr) noexcept {
+    retire(slot, ptr.release(), &details::delete_retired<T>);
+  }
+
+  void retire(const std::size_t slot, void *ptr,
+              void (*deleter)(void *)) noexcept {
+    if (!ptr) {
+      return;
+    }
+    if (!queues_[slot]->try_emplace(details::Retired{ptr, deleter})) {
+      deleter(ptr);
+      inlineDeletes_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Objects destroyed by the reclaimer thread
+  [[nodiscard]] std::uint64_t reclaimed() const noexcept {
+    return reclaimed_.load(std::memory_order_relaxed);
+  }
+
+  // Objects destroyed on a hot thread because its retire queue was full
+  [[nodiscard]] std::uint64_t inline_deletes() const noexcept {
+    return inlineDeletes_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] std::size_t threads() const noexcept { return queues_.size(); }
+
+private:
+  void run() {
+    while (true) {
+      if (reclaim()) {
+        continue;
+      }
+      std::unique_lock lock(mutex_);
+      if (wake_.wait_for(lock, interval_, [this] { return stop_; })) {
+        break;
+      }
+    }
+    // Retired objects outlive the hot threads until reclaimed here
+    while (reclaim()) {
+    }
+  }
+
+  // Returns the number of objects destroyed in one pass over the queues
+  std::size_t reclaim() noexcept {
+    std::array<details::Retired, details::RECLAIM_BATCH> batch;
+    std::size_t count{};
+    for (auto &queue : queues_) {
+      // A zero minimum never waits, and the batch is released with a single
+      // read index publish
+      const auto popped =
+          queue->pop_n_wait(batch.begin(), 0, batch.size(),
+                            std::chrono::steady_clock::time_point{});
+      for (std::size_t i{}; i < popped; ++i) {
+        batch[i].deleter_(batch[i].ptr_);
+      }
+      count += popped;
+    }
+    if (count) {
+      reclaimed_.store(reclaimed_.load(std::memory_order_relaxed) + count,
+                       std::memory_order_relaxed);
+    }
+    return count;
+  }
+};
+
+} // namespace dro
+#endif
@@ -0,0 +1,211 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_SCHEDULER
+#define DRO_SCHEDULER
+
+#include <coroutine> // for std::coroutine_handle, std::suspend_always
+#include <cstddef>   // for size_t
+#include <exception> // for std::exception_ptr, std::rethrow_exception
+#include <memory>    // for std::allocator
+#include <utility>   // for std::exchange, std::move
+#include <vector>    // for std::vector
+
+#include <dro/spsc-queue.hpp> // for dro::SPSCQueue, dro::SPSCTraits
+
+namespace dro {
+
+// Queues between stages of the same Scheduler, the producer and consumer
+// share a thread so every index load and store is relaxed
+struct StageTraits : SPSCTraits {
+  static constexpr bool concurrent = false;
+};
+
+template <typename T, std::size_t N = 0, typename Allocator = std::allocator<T>>
+using StageQueue = SPSCQueue<T, N, Allocator, StageTraits>;
+
+// Coroutine of a single pipeline stage, run by a Scheduler
+class Stage {
+public:
+  struct promise_type {
+    // Completes the suspended queue operation, returns false to stay suspended
+    bool (*poll_)(void *){nullptr};
+    void *awaiter_{nullptr};
+    std::exception_ptr exception_;
+
+    Stage get_return_object() noexcept {
+      return Stage(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept {
+      exception_ = std::current_exception();
+    }
+  };
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+
+  explicit Stage(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_(handle) {}
+
+  friend class Scheduler;
+
+public:
+  ~Stage() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+  // Non-Copyable and Movable
+  Stage(const Stage &lhs) = delete;
+  Stage &operator=(const Stage &lhs) = delete;
+  Stage(Stage &&lhs) noexcept : handle_(std::exchange(lhs.handle_, {})) {}
+  Stage &operator=(Stage &&lhs) noexcept {
+    if (this != &lhs) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(lhs.handle_, {});
+    }
+    return *this;
+  }
+
+  [[nodiscard]] bool done() const noexcept {
+    return !handle_ || handle_.done();
+  }
+};
+
+namespace details {
+
+// Tries the queue operation first and only suspends when it cannot complete,
+// the Scheduler then retries it before resuming the stage
+template <typename Derived> struct QueueAwaiter {
+  bool await_ready() { return static_cast<Derived *>(this)->poll(); }
+
+  void await_suspend(std::coroutine_handle<Stage::promise_type> handle) {
+    handle.promise().poll_ = [](void *awaiter) {
+      return static_cast<Derived *>(awaiter)->poll();
+    };
+    handle.promise().awaiter_ = static_cast<Derived *>(this);
+  }
+
+  void await_resume() const noexcept {}
+};
+
+template <typename Queue, typename T>
+struct PopAwaiter : QueueAwaiter<PopAwaiter<Queue, T>> {
+  Queue &queue_;
+  T &val_;
+
+  PopAwaiter(Queue &queue, T &val) : queue_(queue), val_(val) {}
+  bool poll() { return queue_.try_pop(val_); }
+};
+
+template <typename Queue, typename T>
+struct PushAwaiter : QueueAwaiter<PushAwaiter<Queue, T>> {
+  Queue &queue_;
+  T val_;
+
+  PushAwaiter(Queue &queue, T &&val) : queue_(queue), val_(std::move(val)) {}
+  bool poll() { return queue_.try_push(std::move(val_)); }
+};
+
+} // namespace details
+
+// co_await pop(queue, val) suspends the stage until the queue is non-empty
+template <typename Queue, typename T>
+[[nodiscard]] auto pop(Queue &queue, T &val) {
+  return details::PopAwaiter<Queue, T>(queue, val);
+}
+
+// co_await push(queue, val) suspends the stage until the queue is non-full
+template <typename Queue, typename T>
+[[nodiscard]] auto push(Queue &queue, T val) {
+  return details::PushAwaiter<Queue, T>(queue, std::move(val));
+}
+
+// Runs many pipeline stages cooperatively on the calling thread. A suspended
+// stage is resumed once its queue operation completes, so stages never block
+// the thread and no context switches occur.
+class Scheduler {
+private:
+  std::vector<Stage> stages_;
+  bool external_{false};
+
+public:
+  Scheduler() = default;
+  ~Scheduler() = default;
+  // Non-Copyable and Non-Movable
+  Scheduler(const Scheduler &lhs) = delete;
+  Scheduler &operator=(const Scheduler &lhs) = delete;
+  Scheduler(Scheduler &&lhs) = delete;
+  Scheduler &operator=(Scheduler &&lhs) = delete;
+
+  // Safe to call from a running stage, the new stage first runs on the next
+  // run_once()
+  void spawn(Stage stage) { stages_.push_back(std::move(stage)); }
+
+  // Resumes every stage that can make progress once, returns false when none
+  // could. Rethrows the first exception escaping a stage.
+  bool run_once() {
+    bool progress{false};
+    // A resumed stage may spawn, which reallocates stages_, so index into the
+    // stages present before the loop
+    const auto count = stages_.size();
+    for (std::size_t i{}; i < count; ++i) {
+      const auto handle = stages_[i].handle_;
+      if (stages_[i].done()) {
+        continue;
+      }
+      auto &promise = handle.promise();
+      if (promise.poll_ && !promise.poll_(promise.awaiter_)) {
+        continue;
+      }
+      promise.poll_ = nullptr;
+      handle.resume();
+      progress = true;
+      if (promise.exception_) {
+        std::rethrow_exception(std::exchange(promise.exception_, {}));
+      }
+    }
+    return progress;
+  }
+
+  // Runs until every stage has finished, returns false if the stages can no
+  // longer make progress e.g. a stage waits on a queue nothing will fill
+  bool run() {
+    while (!done()) {
+      if (!run_once() && !external_) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Keeps run() polling stalled stages that wait on queues filled or drained
+  // by other threads, which must use the default concurrent traits
+  void set_external(const bool external) noexcept { external_ = external; }
+
+  [[nodiscard]] bool done() const noexcept {
+    for (const auto &stage : stages_) {
+      if (!stage.done()) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace dro
+#endif
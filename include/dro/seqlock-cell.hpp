@@ -0,0 +1,110 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#ifndef DRO_SEQLOCK_CELL
+#define DRO_SEQLOCK_CELL
+
+#include <array>       // for std::array
+#include <atomic>      // for atomic, memory_order, atomic_thread_fence
+#include <cstddef>     // for size_t
+#include <cstring>     // for memcpy
+#include <type_traits> // for std::is_trivially_copyable
+
+#include <dro/spsc-queue.hpp> // for dro::details::cacheLineSize
+
+namespace dro {
+
+namespace details {
+
+template <typename T>
+concept SeqLock_Type = std::is_trivially_copyable_v<T> &&
+                       std::is_default_constructible_v<T>;
+
+} // namespace details
+
+// Single writer, many readers. The writer never waits and readers retry on
+// torn reads without writing to shared memory.
+template <details::SeqLock_Type T> class SeqLockCell {
+private:
+  // The payload is stored as relaxed atomic words, so a concurrent read of a
+  // torn value is well defined and rejected by the sequence check
+  static constexpr std::size_t words_ =
+      (sizeof(T) + sizeof(std::size_t) - 1) / sizeof(std::size_t);
+  using storage_type = std::array<std::size_t, words_>;
+
+  struct alignas(details::cacheLineSize) CellCacheLine {
+    std::atomic<std::size_t> sequence_{0};
+    std::array<std::atomic<std::size_t>, words_> data_{};
+  } cell_;
+
+public:
+  explicit SeqLockCell(const T &val = T{}) noexcept {
+    storage_type words{};
+    std::memcpy(words.data(), &val, sizeof(T));
+    for (std::size_t i{}; i < words_; ++i) {
+      cell_.data_[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  ~SeqLockCell() = default;
+  // Non-Copyable and Non-Movable
+  SeqLockCell(const SeqLockCell &lhs) = delete;
+  SeqLockCell &operator=(const SeqLockCell &lhs) = delete;
+  SeqLockCell(SeqLockCell &&lhs) = delete;
+  SeqLockCell &operator=(SeqLockCell &&lhs) = delete;
+
+  void store(const T &val) noexcept {
+    storage_type words{};
+    std::memcpy(words.data(), &val, sizeof(T));
+    const auto sequence = cell_.sequence_.load(std::memory_order_relaxed);
+    // Odd sequence marks a write in progress
+    cell_.sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i{}; i < words_; ++i) {
+      cell_.data_[i].store(words[i], std::memory_order_relaxed);
+    }
+    cell_.sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  [[nodiscard]] T load() const noexcept {
+    T val;
+    // Loop while the writer is mid update
+    while (!try_load(val)) {
+    }
+    return val;
+  }
+
+  [[nodiscard]] bool try_load(T &val) const noexcept {
+    storage_type words;
+    const auto sequence = cell_.sequence_.load(std::memory_order_acquire);
+    if (sequence & 1) {
+      return false;
+    }
+    for (std::size_t i{}; i < words_; ++i) {
+      words[i] = cell_.data_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence != cell_.sequence_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    std::memcpy(&val, words.data(), sizeof(T));
+    return true;
+  }
+
+  // Number of completed stores, useful to detect a changed value cheaply
+  [[nodiscard]] std::size_t version() const noexcept {
+    return cell_.sequence_.load(std::memory_order_acquire) / 2;
+  }
+};
+
+} // namespace dro
+#endif
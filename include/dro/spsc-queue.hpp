@@ -13,19 +13,60 @@
 #ifndef DRO_SPSC_QUEUE
 #define DRO_SPSC_QUEUE
 
+#include <algorithm>   // for std::min
 #include <array>       // for std::array
 #include <atomic>      // for atomic, memory_order
+#include <chrono>      // for steady_clock, duration
 #include <concepts>    // for concept, requires
 #include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <functional>  // for std::function
+#include <iterator>    // for std::output_iterator
 #include <limits>      // for numeric_limits
+#include <memory>      // for allocator_traits
 #include <new>         // for std::hardware_destructive_interference_size
 #include <stdexcept>   // for std::logic_error
+#include <stop_token>  // for std::stop_token, std::stop_callback
+#include <thread>      // for std::this_thread::yield
 #include <type_traits> // for std::is_default_constructible
 #include <utility>     // for forward
 #include <vector>      // for vector, allocator
 
+#if defined(__linux__)
+#include <ctime>         // for timespec
+#include <linux/futex.h> // for FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <sys/syscall.h> // for SYS_futex
+#include <unistd.h>      // for syscall
+#endif
+
+// USDT static tracepoints on the slow paths, compiled out unless enabled
+#ifdef DRO_SPSC_USDT
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h> // for STAP_PROBEV
+#define DRO_SPSC_PROBE(name, ...) STAP_PROBEV(dro_spsc, name, __VA_ARGS__)
+#else
+#error "DRO_SPSC_USDT requires <sys/sdt.h> from systemtap-sdt-dev"
+#endif
+#else
+#define DRO_SPSC_PROBE(name, ...) static_cast<void>(0)
+#endif
+
 namespace dro {
 
+// Behaviour of push and emplace when the queue is full
+enum class FullPolicy {
+  Block,     // Waits for the consumer
+  Overwrite, // Overruns the consumer, as with force_push
+  Drop       // Discards the new element
+};
+
+// Behaviour of the producer and consumer while waiting on the other side
+enum class WaitPolicy {
+  Spin, // Busy polls, lowest latency on an isolated core
+  Yield,   // Yields the core between polls
+  Adaptive // Spins for a learned duration, then parks the thread
+};
+
 namespace details {
 
 #ifdef __cpp_lib_hardware_interference_size
@@ -37,6 +78,13 @@ static constexpr std::size_t cacheLineSize = 64;
 
 static constexpr std::size_t MAX_BYTES_ON_STACK = 2'097'152; // 2 MBs
 
+// Power of two number of operations between monitor publications
+static constexpr std::size_t MONITOR_INTERVAL = 1'024;
+
+// Roughly the cost of parking and waking a thread. Typical waits longer than
+// this are not worth spinning for.
+static constexpr std::int64_t PARK_SPIN_LIMIT_NS = 20'000;
+
 template <typename T>
 concept SPSC_Type =
     std::is_default_constructible<T>::value &&
@@ -53,6 +101,28 @@ concept SPSC_NoThrow_Type =
 template <typename T, std::size_t N>
 concept MAX_STACK_SIZE = (N <= (MAX_BYTES_ON_STACK / sizeof(T)));
 
+// Clock used to timestamp elements on enqueue, void disables timestamps
+template <typename Clock>
+concept SPSC_Clock = std::is_void_v<Clock> || requires {
+  typename Clock::time_point;
+  typename Clock::duration;
+  { Clock::now() } -> std::same_as<typename Clock::time_point>;
+};
+
+template <typename Traits>
+concept SPSC_Traits = requires {
+  { Traits::full_policy } -> std::convertible_to<FullPolicy>;
+  { Traits::wait_policy } -> std::convertible_to<WaitPolicy>;
+  { Traits::publish_batch } -> std::convertible_to<std::size_t>;
+  { Traits::adaptive_publish } -> std::convertible_to<bool>;
+  { Traits::enable_stats } -> std::convertible_to<bool>;
+  { Traits::alignment } -> std::convertible_to<std::size_t>;
+  { Traits::concurrent } -> std::convertible_to<bool>;
+  typename Traits::clock_type;
+} && SPSC_Clock<typename Traits::clock_type> && (Traits::publish_batch > 0) &&
+                      (Traits::alignment >= alignof(std::max_align_t)) &&
+                      !(Traits::alignment & (Traits::alignment - 1));
+
 // Memory Allocated on the Heap (Default Option)
 template <SPSC_Type T, typename Allocator = std::allocator<T>>
 struct HeapBuffer {
@@ -112,10 +182,166 @@ struct StackBuffer {
   StackBuffer &operator=(StackBuffer &&lhs) = delete;
 };
 
+// Cold statistics owned by one side and read by a monitoring thread
+struct alignas(cacheLineSize) MonitorCacheLine {
+  std::atomic<std::uint64_t> sequence_{0};
+  std::atomic<std::uint64_t> stalls_{0};
+  // Only written by the producer
+  std::atomic<std::uint64_t> dropped_{0};
+
+  void publish(const std::uint64_t sequence) noexcept {
+    sequence_.store(sequence, std::memory_order_relaxed);
+  }
+
+  // Single writer, so a read-modify-write is not required
+  void add_stall() noexcept {
+    stalls_.store(stalls_.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  void add_dropped(const std::uint64_t count) noexcept {
+    dropped_.store(dropped_.load(std::memory_order_relaxed) + count,
+                   std::memory_order_relaxed);
+  }
+};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+              sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+
+#if defined(__linux__)
+// Blocks while signal holds expected, until unpark or the timeout
+inline void park(std::atomic<std::uint32_t> &signal,
+                 const std::uint32_t expected,
+                 const std::chrono::nanoseconds timeout) noexcept {
+  timespec spec{};
+  timespec *specPtr{nullptr};
+  if (timeout != std::chrono::nanoseconds::max()) {
+    const auto seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    spec.tv_sec = seconds.count();
+    spec.tv_nsec = (timeout - seconds).count();
+    specPtr = &spec;
+  }
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&signal),
+          FUTEX_WAIT_PRIVATE, expected, specPtr, nullptr, 0);
+}
+
+inline void unpark(std::atomic<std::uint32_t> &signal) noexcept {
+  syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&signal),
+          FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+#else
+// std::atomic::wait has no timeout, so timed waits sleep in short slices
+inline void park(std::atomic<std::uint32_t> &signal,
+                 const std::uint32_t expected,
+                 const std::chrono::nanoseconds timeout) noexcept {
+  if (timeout == std::chrono::nanoseconds::max()) {
+    signal.wait(expected, std::memory_order_acquire);
+  } else {
+    std::this_thread::sleep_for(
+        std::min(timeout, std::chrono::nanoseconds(PARK_SPIN_LIMIT_NS)));
+  }
+}
+
+inline void unpark(std::atomic<std::uint32_t> &signal) noexcept {
+  signal.notify_one();
+}
+#endif
+
+// Enqueue timestamps stored in a side array aligned with the slots
+template <typename Clock, std::size_t N, typename Allocator>
+struct TimestampBuffer {
+  using time_point = typename Clock::time_point;
+  using allocator_type = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<time_point>;
+  std::conditional_t<N == 0, std::vector<time_point, allocator_type>,
+                     std::array<time_point, N + 1>>
+      stamps_{};
+
+  TimestampBuffer(const std::size_t capacity, const Allocator &allocator) {
+    if constexpr (N == 0) {
+      stamps_ = std::vector<time_point, allocator_type>(
+          capacity, allocator_type(allocator));
+    }
+  }
+};
+
+// Timestamps disabled, occupies no storage
+template <std::size_t N, typename Allocator>
+struct TimestampBuffer<void, N, Allocator> {
+  TimestampBuffer(const std::size_t, const Allocator &) {}
+};
+
 } // namespace details
 
+// Default configuration and the behaviour of SPSCQueue<T, N, Allocator>.
+// Derive from it and override members to configure a deployment at compile
+// time, e.g. struct MyTraits : dro::SPSCTraits { using clock_type = ...; };
+struct SPSCTraits {
+  static constexpr FullPolicy full_policy = FullPolicy::Block;
+  static constexpr WaitPolicy wait_policy = WaitPolicy::Spin;
+  // Producer writes per writeIndex_ store, the producer must flush() when idle
+  static constexpr std::size_t publish_batch = 1;
+  // Publishes every write while the consumer keeps up, and batches by
+  // publish_batch only while the consumer lags
+  static constexpr bool adaptive_publish = false;
+  // Clock used to timestamp elements on enqueue, void disables timestamps
+  using clock_type = void;
+  // Stall counts and sequences for monitor_snapshot and the metrics registry
+  static constexpr bool enable_stats = true;
+  // Alignment of the producer and consumer cache lines, e.g. 128 where the
+  // prefetcher pulls in adjacent cache line pairs
+  static constexpr std::size_t alignment = details::cacheLineSize;
+  // False when the producer and consumer run on the same thread, e.g. stages
+  // of a dro::Scheduler, which relaxes every index load and store
+  static constexpr bool concurrent = true;
+};
+
+// Approximate queue state built only from the cold monitor cache lines
+struct MonitorSnapshot {
+  std::uint64_t writeSequence_{};
+  std::uint64_t readSequence_{};
+  std::uint64_t fullStalls_{};
+  std::uint64_t emptyStalls_{};
+  // Lost to an overrun or refused by FullPolicy::Drop
+  std::uint64_t dropped_{};
+  std::chrono::steady_clock::time_point time_{};
+
+  [[nodiscard]] std::size_t size() const noexcept {
+    // Each side publishes independently, so the reader can appear ahead
+    return (writeSequence_ > readSequence_) ? writeSequence_ - readSequence_
+                                            : 0;
+  }
+
+  // Elements per second written since the previous snapshot
+  [[nodiscard]] double write_rate(const MonitorSnapshot &prev) const noexcept {
+    return rate(writeSequence_ - prev.writeSequence_, prev);
+  }
+
+  // Elements per second read since the previous snapshot
+  [[nodiscard]] double read_rate(const MonitorSnapshot &prev) const noexcept {
+    return rate(readSequence_ - prev.readSequence_, prev);
+  }
+
+  // Seconds for the consumer to drain the backlog at its current rate
+  [[nodiscard]] double lag(const MonitorSnapshot &prev) const noexcept {
+    const auto readRate = read_rate(prev);
+    return (readRate > 0.0) ? static_cast<double>(size()) / readRate : 0.0;
+  }
+
+private:
+  [[nodiscard]] double rate(const std::uint64_t count,
+                            const MonitorSnapshot &prev) const noexcept {
+    const std::chrono::duration<double> elapsed = time_ - prev.time_;
+    return (elapsed.count() > 0.0)
+               ? static_cast<double>(count) / elapsed.count()
+               : 0.0;
+  }
+};
+
 template <details::SPSC_Type T, std::size_t N = 0,
-          typename Allocator = std::allocator<T>>
+          typename Allocator = std::allocator<T>,
+          details::SPSC_Traits Traits = SPSCTraits>
   requires details::MAX_STACK_SIZE<T, N>
 class SPSCQueue
     : public std::conditional_t<N == 0, details::HeapBuffer<T, Allocator>,
@@ -125,26 +351,110 @@ private:
       std::conditional_t<N == 0, details::HeapBuffer<T, Allocator>,
                          details::StackBuffer<T, N>>;
   static constexpr bool nothrow_v = details::SPSC_NoThrow_Type<T>;
+  using Clock = typename Traits::clock_type;
+  static constexpr bool timestamped_v = !std::is_void_v<Clock>;
+  static constexpr bool batched_v = Traits::publish_batch > 1;
+  static constexpr bool adaptive_v = batched_v && Traits::adaptive_publish;
+  static constexpr bool parking_v =
+      Traits::wait_policy == WaitPolicy::Adaptive;
+  static constexpr auto acquire_v = Traits::concurrent
+                                        ? std::memory_order_acquire
+                                        : std::memory_order_relaxed;
+  static constexpr auto release_v = Traits::concurrent
+                                        ? std::memory_order_release
+                                        : std::memory_order_relaxed;
+  static_assert(Traits::concurrent || !parking_v,
+                "A single threaded queue must never park");
 
-  struct alignas(details::cacheLineSize) WriterCacheLine {
+  // Note: With watermarks enabled the index caches hold the next index where
+  // the slow path must run, which is never past the true peer index
+  struct alignas(Traits::alignment) WriterCacheLine {
     std::atomic<std::size_t> writeIndex_{0};
+    // Producer index ahead of writeIndex_ when publication is batched
+    std::size_t pendingIndex_{0};
+    std::size_t pendingCount_{0};
+    std::size_t batchLimit_{Traits::publish_batch};
     std::size_t readIndexCache_{0};
+    // True read index at the last refresh, unlike the cache never a limit
+    std::size_t lastReadIndex_{0};
     // Reduces cache contention on very small queues
     const size_t paddingCache_ = base_type::padding;
+    std::size_t highWatermark_{0};
+    std::uint64_t writeLaps_{0};
+    // Elements refused by FullPolicy::Drop, which still take a sequence
+    std::uint64_t refusedCount_{0};
+    // Written elements, excluding refusals, at the last refusal
+    std::uint64_t lastRefusedWrite_{0};
+    // Moving average of full waits, sets the spin budget before parking
+    std::int64_t waitNs_{0};
+    details::MonitorCacheLine *monitor_{nullptr};
   } writer_;
 
-  struct alignas(details::cacheLineSize) ReaderCacheLine {
+  struct alignas(Traits::alignment) ReaderCacheLine {
     std::atomic<std::size_t> readIndex_{0};
     std::size_t writeIndexCache_{0};
+    // True write index at the last refresh, unlike the cache never a limit
+    std::size_t lastWriteIndex_{0};
     // Reduces cache contention on very small queues
     std::size_t capacityCache_{};
+    std::size_t expiredCount_{0};
+    std::size_t lowWatermark_{0};
+    // A low watermark of 0 is valid, so it cannot double as the enabled flag
+    bool watermarks_{false};
+    std::uint64_t readLaps_{0};
+    std::uint64_t droppedCache_{0};
+    std::uint64_t refusedCache_{0};
+    // Moving average of empty waits, sets the spin budget before parking
+    std::int64_t waitNs_{0};
+    details::MonitorCacheLine *monitor_{nullptr};
   } reader_;
 
+  // Only accessed on the slow paths
+  struct alignas(Traits::alignment) SlowPathCacheLine {
+    std::atomic<std::uint64_t> dropped_{0};
+    // Elements refused by FullPolicy::Drop, and the written elements before
+    // the last refusal
+    std::atomic<std::uint64_t> refused_{0};
+    std::atomic<std::uint64_t> refusedWrite_{0};
+    std::atomic<bool> aboveHigh_{false};
+    std::function<void()> onHigh_;
+    std::function<void()> onLow_;
+    // Copies for monitor_snapshot, which must not read the hot cache lines
+    details::MonitorCacheLine *writerMonitor_{nullptr};
+    details::MonitorCacheLine *readerMonitor_{nullptr};
+  } slowPath_;
+
+  // Only written while a side parks, otherwise read by the other side after
+  // each publish with WaitPolicy::Adaptive
+  struct alignas(Traits::alignment) ParkCacheLine {
+    std::atomic<std::uint32_t> writerSignal_{0};
+    std::atomic<std::uint32_t> readerSignal_{0};
+    std::atomic<bool> writerParked_{false};
+    std::atomic<bool> readerParked_{false};
+    // Woken once the write index is readerNeed_ past readerFrom_
+    std::atomic<std::size_t> readerFrom_{0};
+    std::atomic<std::size_t> readerNeed_{1};
+  } park_;
+
+  // Default monitor storage, replaced by attach_monitor
+  details::MonitorCacheLine writerMonitor_;
+  details::MonitorCacheLine readerMonitor_;
+
+  [[no_unique_address]] details::TimestampBuffer<Clock, N, Allocator> stamps_;
+
 public:
+  using value_type = T;
+
   explicit SPSCQueue(const std::size_t capacity = 0,
                      const Allocator &allocator = Allocator())
-      : base_type(capacity, allocator) {
+      : base_type(capacity, allocator),
+        stamps_(base_type::capacity_, allocator) {
     reader_.capacityCache_ = base_type::capacity_;
+    if constexpr (adaptive_v) {
+      // Sends the first write through the slow path to start sampling the lag
+      writer_.readIndexCache_ = 1;
+    }
+    attach_monitor(writerMonitor_, readerMonitor_);
   }
 
   ~SPSCQueue() = default;
@@ -158,49 +468,128 @@ public:
     requires std::constructible_from<T, Args &&...>
   void
   emplace(Args &&...args) noexcept(details::SPSC_NoThrow_Type<T, Args &&...>) {
-    const auto writeIndex = writer_.writeIndex_.load(std::memory_order_relaxed);
+    if constexpr (Traits::full_policy == FullPolicy::Overwrite) {
+      force_emplace(std::forward<Args>(args)...);
+      return;
+    } else if constexpr (Traits::full_policy == FullPolicy::Drop) {
+      static_cast<void>(drop_emplace(std::forward<Args>(args)...));
+      return;
+    }
+    const auto writeIndex = load_write_index();
     const auto nextWriteIndex =
         (writeIndex == base_type::capacity_ - 1) ? 0 : writeIndex + 1;
     // Loop while waiting for reader to catch up
-    while (nextWriteIndex == writer_.readIndexCache_) {
-      writer_.readIndexCache_ =
-          reader_.readIndex_.load(std::memory_order_acquire);
+    if (nextWriteIndex == writer_.readIndexCache_ &&
+        !refresh_read_index(nextWriteIndex)) {
+      wait_read_index(nextWriteIndex);
+    }
+    write_value(writeIndex, std::forward<Args>(args)...);
+    write_stamp(writeIndex);
+    store_write_index(nextWriteIndex);
+  }
+
+  // Returns false if stop is requested while waiting on a full queue, which
+  // is only checked on the slow path. The full policy applies as in emplace.
+  template <typename... Args>
+    requires std::constructible_from<T, Args &&...>
+  [[nodiscard]] bool
+  emplace(const std::stop_token &token,
+          Args &&...args) noexcept(details::SPSC_NoThrow_Type<T, Args &&...>) {
+    if constexpr (Traits::full_policy == FullPolicy::Overwrite) {
+      force_emplace(std::forward<Args>(args)...);
+      return true;
+    } else if constexpr (Traits::full_policy == FullPolicy::Drop) {
+      return drop_emplace(std::forward<Args>(args)...);
+    }
+    const auto writeIndex = load_write_index();
+    const auto nextWriteIndex =
+        (writeIndex == base_type::capacity_ - 1) ? 0 : writeIndex + 1;
+    if (nextWriteIndex == writer_.readIndexCache_ &&
+        !refresh_read_index(nextWriteIndex) &&
+        !wait_read_index(nextWriteIndex, token)) {
+      return false;
     }
     write_value(writeIndex, std::forward<Args>(args)...);
-    writer_.writeIndex_.store(nextWriteIndex, std::memory_order_release);
+    write_stamp(writeIndex);
+    store_write_index(nextWriteIndex);
+    return true;
   }
 
   template <typename... Args>
     requires std::constructible_from<T, Args &&...>
   void force_emplace(Args &&...args) noexcept(
       details::SPSC_NoThrow_Type<T, Args &&...>) {
-    const auto writeIndex = writer_.writeIndex_.load(std::memory_order_relaxed);
+    const auto writeIndex = load_write_index();
     const auto nextWriteIndex =
         (writeIndex == base_type::capacity_ - 1) ? 0 : writeIndex + 1;
+    // Check reader cache and if actually equal then the reader is overrun
+    if (nextWriteIndex == writer_.readIndexCache_ &&
+        !refresh_read_index(nextWriteIndex)) {
+      // The queue reads as empty, so every slot of the lap is lost
+      slowPath_.dropped_.fetch_add(base_type::capacity_,
+                                   std::memory_order_relaxed);
+      add_dropped(base_type::capacity_);
+      DRO_SPSC_PROBE(overrun, this, base_type::capacity_);
+    }
     write_value(writeIndex, std::forward<Args>(args)...);
-    writer_.writeIndex_.store(nextWriteIndex, std::memory_order_release);
+    write_stamp(writeIndex);
+    store_write_index(nextWriteIndex);
   }
 
   template <typename... Args>
     requires std::constructible_from<T, Args &&...>
   [[nodiscard]] bool try_emplace(Args &&...args) noexcept(
       details::SPSC_NoThrow_Type<T, Args &&...>) {
-    const auto writeIndex = writer_.writeIndex_.load(std::memory_order_relaxed);
+    const auto writeIndex = load_write_index();
     const auto nextWriteIndex =
         (writeIndex == base_type::capacity_ - 1) ? 0 : writeIndex + 1;
     // Check reader cache and if actually equal then fail to write
-    if (nextWriteIndex == writer_.readIndexCache_) {
-      writer_.readIndexCache_ =
-          reader_.readIndex_.load(std::memory_order_acquire);
-      if (nextWriteIndex == writer_.readIndexCache_) {
-        return false;
-      }
+    if (nextWriteIndex == writer_.readIndexCache_ &&
+        !refresh_read_index(nextWriteIndex)) {
+      add_stall(writer_.monitor_);
+      DRO_SPSC_PROBE(try_emplace_full, this);
+      return false;
     }
     write_value(writeIndex, std::forward<Args>(args)...);
-    writer_.writeIndex_.store(nextWriteIndex, std::memory_order_release);
+    write_stamp(writeIndex);
+    store_write_index(nextWriteIndex);
     return true;
   }
 
+  // Producer only. Returns the next free slot in place, or nullptr if the
+  // queue is full. The slot still holds the element last read from it.
+  [[nodiscard]] T *claim() noexcept {
+    const auto writeIndex = load_write_index();
+    const auto nextWriteIndex =
+        (writeIndex == base_type::capacity_ - 1) ? 0 : writeIndex + 1;
+    if (nextWriteIndex == writer_.readIndexCache_ &&
+        !refresh_read_index(nextWriteIndex)) {
+      return nullptr;
+    }
+    return &base_type::buffer_[writeIndex + writer_.paddingCache_];
+  }
+
+  // Producer only. Publishes the slot returned by claim(), which must not
+  // have been nullptr.
+  void commit() noexcept {
+    const auto writeIndex = load_write_index();
+    const auto nextWriteIndex =
+        (writeIndex == base_type::capacity_ - 1) ? 0 : writeIndex + 1;
+    write_stamp(writeIndex);
+    store_write_index(nextWriteIndex);
+  }
+
+  // Calls func on every slot, including the one kept free, e.g. to reserve
+  // storage claim() later hands out. Not thread safe, call before the
+  // producer and consumer start.
+  template <typename F>
+    requires std::invocable<F &, T &>
+  void initialize_slots(F &&func) {
+    for (std::size_t i{}; i < base_type::capacity_; ++i) {
+      func(base_type::buffer_[i + base_type::padding]);
+    }
+  }
+
   void push(const T &val) noexcept(nothrow_v) { emplace(val); }
 
   template <typename P>
@@ -231,36 +620,356 @@ public:
   void pop(T &val) noexcept(nothrow_v) {
     const auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
     // Loop while waiting for writer to enqueue
-    while (readIndex == reader_.writeIndexCache_) {
-      reader_.writeIndexCache_ =
-          writer_.writeIndex_.load(std::memory_order_acquire);
+    if (readIndex == reader_.writeIndexCache_ &&
+        !refresh_write_index(readIndex)) {
+      wait_write_index(readIndex);
     }
     val = read_value(readIndex);
     const auto nextReadIndex =
         (readIndex == reader_.capacityCache_ - 1) ? 0 : readIndex + 1;
-    reader_.readIndex_.store(nextReadIndex, std::memory_order_release);
+    store_read_index(nextReadIndex);
+  }
+
+  // Returns false if stop is requested while waiting on an empty queue. The
+  // token is only checked on the slow path, so ready elements are drained.
+  [[nodiscard]] bool pop(T &val,
+                         const std::stop_token &token) noexcept(nothrow_v) {
+    const auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
+    if (readIndex == reader_.writeIndexCache_ &&
+        !refresh_write_index(readIndex) &&
+        !wait_write_index(readIndex, token)) {
+      return false;
+    }
+    val = read_value(readIndex);
+    const auto nextReadIndex =
+        (readIndex == reader_.capacityCache_ - 1) ? 0 : readIndex + 1;
+    store_read_index(nextReadIndex);
+    return true;
   }
 
   [[nodiscard]] bool try_pop(T &val) noexcept(nothrow_v) {
     const auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
     // Check writer cache and if actually equal then fail to read
-    if (readIndex == reader_.writeIndexCache_) {
-      reader_.writeIndexCache_ =
-          writer_.writeIndex_.load(std::memory_order_acquire);
-      if (readIndex == reader_.writeIndexCache_) {
-        return false;
-      }
+    if (readIndex == reader_.writeIndexCache_ &&
+        !refresh_write_index(readIndex)) {
+      add_stall(reader_.monitor_);
+      DRO_SPSC_PROBE(try_pop_empty, this);
+      return false;
     }
     val = read_value(readIndex);
     const auto nextReadIndex =
         (readIndex == reader_.capacityCache_ - 1) ? 0 : readIndex + 1;
-    reader_.readIndex_.store(nextReadIndex, std::memory_order_release);
+    store_read_index(nextReadIndex);
     return true;
   }
 
+  // Consumer only. Returns the oldest element in place, or nullptr if the
+  // queue is empty. The element stays valid until pop().
+  [[nodiscard]] T *front() noexcept {
+    const auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
+    if (readIndex == reader_.writeIndexCache_ &&
+        !refresh_write_index(readIndex)) {
+      return nullptr;
+    }
+    return &base_type::buffer_[readIndex + base_type::padding];
+  }
+
+  // Consumer only. Releases the element returned by front(), which must not
+  // have been nullptr.
+  void pop() noexcept {
+    const auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
+    const auto nextReadIndex =
+        (readIndex == reader_.capacityCache_ - 1) ? 0 : readIndex + 1;
+    store_read_index(nextReadIndex);
+  }
+
+  // Consumer only. Discards all but the newest keep elements with a single
+  // read index publish, and returns the number discarded. Skipped elements
+  // are not moved out, they stay in their slots until overwritten.
+  std::size_t skip_to_latest(const std::size_t keep) noexcept {
+    auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
+    static_cast<void>(refresh_write_index(readIndex));
+    const auto available = distance(readIndex, reader_.lastWriteIndex_);
+    if (available <= keep) {
+      return 0;
+    }
+    readIndex = advance_read_index(readIndex, available - keep);
+    publish_read_index(readIndex);
+    // A watermark limit in the cache may now lie behind the read index
+    static_cast<void>(refresh_write_index(readIndex));
+    return available - keep;
+  }
+
+  // Consumer only. Discards every element ready to be read.
+  std::size_t clear() noexcept { return skip_to_latest(0); }
+
+  // Skips elements older than maxAge in bulk, then pops the oldest fresh one
+  template <typename Duration>
+    requires timestamped_v
+  [[nodiscard]] bool pop_fresh(T &val,
+                               const Duration &maxAge) noexcept(nothrow_v) {
+    const auto oldest = Clock::now() - maxAge;
+    auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
+    const auto expiredCount = reader_.expiredCount_;
+    while (true) {
+      // Check writer cache and if actually equal then nothing left to read
+      if (readIndex == reader_.writeIndexCache_ &&
+          !refresh_write_index(readIndex)) {
+        break;
+      }
+      // Stamps are non-decreasing between the indexes, so binary search for
+      // the first fresh element
+      const auto available = distance(readIndex, reader_.writeIndexCache_);
+      std::size_t low{};
+      std::size_t high{available};
+      while (low < high) {
+        const auto mid = low + ((high - low) / 2);
+        if (stamps_.stamps_[wrap_index(readIndex + mid)] < oldest) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      reader_.expiredCount_ += low;
+      readIndex = advance_read_index(readIndex, low);
+      if (low < available) {
+        val = read_value(readIndex);
+        readIndex = advance_read_index(readIndex, 1);
+        publish_read_index(readIndex);
+        publish_read_sequence();
+        return true;
+      }
+    }
+    // Publish the skipped elements with a single store
+    if (reader_.expiredCount_ != expiredCount) {
+      publish_read_index(readIndex);
+      publish_read_sequence();
+    }
+    return false;
+  }
+
+  // Waits until minCount elements are ready or the deadline passes, then moves
+  // up to maxCount elements to out with a single publish. Returns the number
+  // moved, which is below minCount only when the deadline passed.
+  template <typename OutputIt, typename WaitClock, typename Duration>
+    requires std::output_iterator<OutputIt, T &&> ||
+             std::output_iterator<OutputIt, T &>
+  std::size_t
+  pop_n_wait(OutputIt out, const std::size_t minCount,
+             const std::size_t maxCount,
+             const std::chrono::time_point<WaitClock, Duration> &deadline) {
+    auto readIndex = reader_.readIndex_.load(std::memory_order_relaxed);
+    // A full queue holds capacity elements, so never wait for more
+    const auto target = std::min({minCount, maxCount, capacity()});
+    if (distance(readIndex, reader_.writeIndexCache_) < target) {
+      wait_available(readIndex, target, deadline);
+    }
+    std::size_t count{};
+    while (count < maxCount) {
+      // The cache may stop short of the writer at a watermark limit, so the
+      // slow path still runs at the same index as for single pops
+      if (readIndex == reader_.writeIndexCache_ &&
+          !refresh_write_index(readIndex)) {
+        break;
+      }
+      const auto segment = std::min(
+          maxCount - count, distance(readIndex, reader_.writeIndexCache_));
+      for (std::size_t i{}; i < segment; ++i) {
+        *out = read_value(readIndex);
+        ++out;
+        readIndex = advance_read_index(readIndex, 1);
+      }
+      count += segment;
+    }
+    if (count) {
+      publish_read_index(readIndex);
+      publish_read_sequence();
+    }
+    return count;
+  }
+
+  [[nodiscard]] std::size_t expired() const noexcept
+    requires timestamped_v
+  {
+    return reader_.expiredCount_;
+  }
+
+  // Not thread safe, configure before the producer and consumer start. The
+  // high callback runs on the producer and the low callback on the consumer
+  void set_watermarks(const std::size_t high, const std::size_t low,
+                      std::function<void()> onHigh,
+                      std::function<void()> onLow) {
+    if (high > capacity() || low >= high) {
+      throw std::invalid_argument(
+          "Watermarks must satisfy low < high <= capacity");
+    }
+    slowPath_.onHigh_ = std::move(onHigh);
+    slowPath_.onLow_ = std::move(onLow);
+    slowPath_.aboveHigh_.store(false, std::memory_order_relaxed);
+    writer_.highWatermark_ = high;
+    reader_.lowWatermark_ = low;
+    reader_.watermarks_ = true;
+    // Sends both sides through the slow path on their next operation
+    writer_.readIndexCache_ =
+        wrap_index(load_write_index() + 1);
+    reader_.writeIndexCache_ =
+        reader_.readIndex_.load(std::memory_order_relaxed);
+  }
+
+  // Sequence numbers start at 1, and 0 means no element has been written.
+  // Elements refused by FullPolicy::Drop take a sequence number.
+  [[nodiscard]] std::uint64_t last_write_sequence() const noexcept {
+    return written_sequence() + writer_.refusedCount_;
+  }
+
+  // Includes elements lost to force_emplace or refused by FullPolicy::Drop,
+  // so a jump of more than one between reads reports a gap
+  [[nodiscard]] std::uint64_t last_read_sequence() const noexcept {
+    return (reader_.readLaps_ * reader_.capacityCache_) +
+           reader_.readIndex_.load(std::memory_order_relaxed) +
+           reader_.droppedCache_ + reader_.refusedCache_;
+  }
+
+  // Producer only. Emplaces and returns the element's ticket, its sequence
+  // number, for is_consumed and wait_until_consumed. Returns 0 if the element
+  // was dropped, a ticket that is always consumed.
+  template <typename... Args>
+    requires std::constructible_from<T, Args &&...>
+  [[nodiscard]] std::uint64_t emplace_ticket(Args &&...args) noexcept(
+      details::SPSC_NoThrow_Type<T, Args &&...>) {
+    if constexpr (Traits::full_policy == FullPolicy::Drop) {
+      if (!drop_emplace(std::forward<Args>(args)...)) {
+        return 0;
+      }
+    } else {
+      emplace(std::forward<Args>(args)...);
+    }
+    return last_write_sequence();
+  }
+
+  // Producer only. True once the consumer has released the ticket's element
+  // and every element before it. The consumer is never a lap behind, so its
+  // sequence follows from the read index. Not meaningful with Overwrite.
+  [[nodiscard]] bool is_consumed(const std::uint64_t ticket) const noexcept {
+    const auto readIndex = reader_.readIndex_.load(acquire_v);
+    const auto consumed =
+        written_sequence() - distance(readIndex, load_write_index());
+    // A refusal follows every element written before it, so until the
+    // consumer passes the last refusal only written elements are counted
+    return ((consumed >= writer_.lastRefusedWrite_)
+                ? consumed + writer_.refusedCount_
+                : consumed) >= ticket;
+  }
+
+  // Producer only. Publishes pending writes, then waits following the wait
+  // policy until is_consumed(ticket)
+  void wait_until_consumed(const std::uint64_t ticket) noexcept {
+    flush();
+    if (is_consumed(ticket)) {
+      return;
+    }
+    if constexpr (parking_v) {
+      // The consumer wakes the parked producer on every read index publish
+      static_cast<void>(park_wait(
+          writer_.waitNs_, park_.writerSignal_, park_.writerParked_,
+          [&] { return is_consumed(ticket); },
+          [] { return std::chrono::nanoseconds::max(); }));
+    } else {
+      while (!is_consumed(ticket)) {
+        backoff();
+      }
+    }
+  }
+
+  // Number of elements lost when force_emplace overran the reader or refused
+  // by FullPolicy::Drop
+  [[nodiscard]] std::uint64_t dropped() const noexcept {
+    return slowPath_.dropped_.load(std::memory_order_relaxed) +
+           slowPath_.refused_.load(std::memory_order_relaxed);
+  }
+
+  // Not thread safe, attach before the producer and consumer start. Moves the
+  // cold statistics into external storage such as a shared memory segment
+  void attach_monitor(details::MonitorCacheLine &writer,
+                      details::MonitorCacheLine &reader) noexcept {
+    writer.publish(last_write_sequence());
+    reader.publish(last_read_sequence());
+    if (writer_.monitor_) {
+      writer.stalls_.store(
+          writer_.monitor_->stalls_.load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      reader.stalls_.store(
+          reader_.monitor_->stalls_.load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      writer.dropped_.store(
+          writer_.monitor_->dropped_.load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    writer_.monitor_ = &writer;
+    reader_.monitor_ = &reader;
+    slowPath_.writerMonitor_ = &writer;
+    slowPath_.readerMonitor_ = &reader;
+  }
+
+  // Restores the default monitor storage
+  void detach_monitor() noexcept {
+    attach_monitor(writerMonitor_, readerMonitor_);
+  }
+
+  // Safe from any thread, never touches the producer or consumer cache lines
+  [[nodiscard]] MonitorSnapshot monitor_snapshot() const noexcept {
+    MonitorSnapshot snapshot;
+    snapshot.writeSequence_ =
+        slowPath_.writerMonitor_->sequence_.load(std::memory_order_relaxed);
+    snapshot.readSequence_ =
+        slowPath_.readerMonitor_->sequence_.load(std::memory_order_relaxed);
+    snapshot.fullStalls_ =
+        slowPath_.writerMonitor_->stalls_.load(std::memory_order_relaxed);
+    snapshot.emptyStalls_ =
+        slowPath_.readerMonitor_->stalls_.load(std::memory_order_relaxed);
+    snapshot.dropped_ =
+        slowPath_.writerMonitor_->dropped_.load(std::memory_order_relaxed);
+    snapshot.time_ = std::chrono::steady_clock::now();
+    return snapshot;
+  }
+
+  // Producer only. Publishes writes held back by Traits::publish_batch, call it
+  // before the producer goes idle or the consumer may wait indefinitely
+  void flush() noexcept {
+    if constexpr (batched_v) {
+      if (writer_.pendingCount_) {
+        writer_.pendingCount_ = 0;
+        publish_write_index(writer_.pendingIndex_);
+      }
+    }
+  }
+
+  // Producer only. Free slots as of the last read index the producer loaded,
+  // so never above the true count and free of consumer cache line traffic
+  // unless refresh is set. Not meaningful with FullPolicy::Overwrite.
+  [[nodiscard]] std::size_t
+  free_slots_lower_bound(const bool refresh = false) noexcept {
+    if (refresh) {
+      writer_.lastReadIndex_ = reader_.readIndex_.load(acquire_v);
+    }
+    return capacity() - distance(writer_.lastReadIndex_, load_write_index());
+  }
+
+  // Consumer only. Elements ready as of the last write index the consumer
+  // loaded, so never above the true count and free of producer cache line
+  // traffic unless refresh is set. Not meaningful with FullPolicy::Overwrite.
+  [[nodiscard]] std::size_t
+  available_lower_bound(const bool refresh = false) noexcept {
+    if (refresh) {
+      reader_.lastWriteIndex_ = writer_.writeIndex_.load(acquire_v);
+    }
+    return distance(reader_.readIndex_.load(std::memory_order_relaxed),
+                    reader_.lastWriteIndex_);
+  }
+
   [[nodiscard]] std::size_t size() const noexcept {
-    const auto writeIndex = writer_.writeIndex_.load(std::memory_order_acquire);
-    const auto readIndex = reader_.readIndex_.load(std::memory_order_acquire);
+    const auto writeIndex = writer_.writeIndex_.load(acquire_v);
+    const auto readIndex = reader_.readIndex_.load(acquire_v);
     // This method prevents conversion to std::ptrdiff_t (a signed type)
     if (writeIndex >= readIndex) {
       return writeIndex - readIndex;
@@ -269,8 +978,8 @@ public:
   }
 
   [[nodiscard]] bool empty() const noexcept {
-    return writer_.writeIndex_.load(std::memory_order_acquire) ==
-           reader_.readIndex_.load(std::memory_order_acquire);
+    return writer_.writeIndex_.load(acquire_v) ==
+           reader_.readIndex_.load(acquire_v);
   }
 
   [[nodiscard]] std::size_t capacity() const noexcept {
@@ -278,6 +987,397 @@ public:
   }
 
 private:
+  // Producer slow path, returns false if the queue is full
+  [[nodiscard]] bool
+  refresh_read_index(const std::size_t nextWriteIndex) noexcept {
+    const auto readIndex = reader_.readIndex_.load(acquire_v);
+    writer_.readIndexCache_ = readIndex;
+    writer_.lastReadIndex_ = readIndex;
+    publish_write_sequence();
+    DRO_SPSC_PROBE(write_refresh, this, nextWriteIndex, readIndex);
+    if (writer_.highWatermark_) [[unlikely]] {
+      check_high_watermark(nextWriteIndex, readIndex);
+    }
+    if constexpr (adaptive_v) {
+      adapt_publication(nextWriteIndex, readIndex);
+    }
+    if (nextWriteIndex == readIndex) {
+      // The consumer may be waiting on elements that are not yet published
+      flush();
+      return false;
+    }
+    return true;
+  }
+
+  void adapt_publication(const std::size_t nextWriteIndex,
+                         const std::size_t readIndex) noexcept {
+    // Elements the consumer has yet to read, including the unpublished ones
+    const auto lag = distance(readIndex, nextWriteIndex);
+    writer_.batchLimit_ =
+        (lag <= Traits::publish_batch) ? 1 : Traits::publish_batch;
+    // Return to the slow path after another batch to sample the lag again
+    if (distance(nextWriteIndex, writer_.readIndexCache_) >
+        Traits::publish_batch) {
+      writer_.readIndexCache_ =
+          wrap_index(nextWriteIndex + Traits::publish_batch);
+    }
+  }
+
+  // Consumer slow path, returns false if the queue is empty
+  [[nodiscard]] bool refresh_write_index(const std::size_t readIndex) noexcept {
+    const auto writeIndex = writer_.writeIndex_.load(acquire_v);
+    reader_.writeIndexCache_ = writeIndex;
+    reader_.lastWriteIndex_ = writeIndex;
+    reader_.droppedCache_ = slowPath_.dropped_.load(std::memory_order_relaxed);
+    DRO_SPSC_PROBE(read_refresh, this, readIndex, writeIndex);
+    if (reader_.watermarks_) [[unlikely]] {
+      check_low_watermark(readIndex, writeIndex);
+    }
+    if constexpr (Traits::full_policy == FullPolicy::Drop) {
+      check_refused(readIndex, writeIndex);
+    }
+    publish_read_sequence();
+    return readIndex != writeIndex;
+  }
+
+  // Counts refused elements into the read sequence once the consumer reaches
+  // the position of the last refusal, so the gap is never reported ahead of
+  // elements written before it
+  void check_refused(const std::size_t readIndex,
+                     const std::size_t writeIndex) noexcept {
+    const auto refused = slowPath_.refused_.load(std::memory_order_acquire);
+    if (refused == reader_.refusedCache_) {
+      return;
+    }
+    // Never older than the position stored with refused
+    const auto refusedWrite =
+        slowPath_.refusedWrite_.load(std::memory_order_relaxed);
+    const auto position =
+        (reader_.readLaps_ * reader_.capacityCache_) + readIndex;
+    if (position >= refusedWrite) {
+      reader_.refusedCache_ = refused;
+    } else if (readIndex != writeIndex &&
+               refusedWrite - position <
+                   distance(readIndex, reader_.writeIndexCache_)) {
+      // Return to the slow path at the position of the refusal
+      reader_.writeIndexCache_ = wrap_index(
+          readIndex + static_cast<std::size_t>(refusedWrite - position));
+    }
+  }
+
+  void check_high_watermark(const std::size_t nextWriteIndex,
+                            const std::size_t readIndex) noexcept {
+    // Size including the element about to be written, a full queue wraps to 0
+    const auto nextSize = distance(readIndex, nextWriteIndex);
+    if (!nextSize || nextSize >= writer_.highWatermark_) {
+      if (!slowPath_.aboveHigh_.exchange(true, std::memory_order_acq_rel) &&
+          slowPath_.onHigh_) {
+        slowPath_.onHigh_();
+      }
+    } else if (!slowPath_.aboveHigh_.load(std::memory_order_acquire)) {
+      // Return to the slow path once the size could reach the watermark
+      writer_.readIndexCache_ = wrap_index(readIndex + writer_.highWatermark_);
+    }
+  }
+
+  void check_low_watermark(const std::size_t readIndex,
+                           const std::size_t writeIndex) noexcept {
+    if (!slowPath_.aboveHigh_.load(std::memory_order_acquire)) {
+      return;
+    }
+    // Size after the element about to be read, an empty queue stays at 0
+    const auto currentSize = distance(readIndex, writeIndex);
+    if (currentSize <= reader_.lowWatermark_ + 1) {
+      slowPath_.aboveHigh_.store(false, std::memory_order_release);
+      if (slowPath_.onLow_) {
+        slowPath_.onLow_();
+      }
+    } else {
+      // Return to the slow path once the size could reach the watermark
+      reader_.writeIndexCache_ = wrap_index(
+          writeIndex + base_type::capacity_ - reader_.lowWatermark_ - 1);
+    }
+  }
+
+  // Returns false if stop was requested before the consumer caught up
+  bool wait_read_index(const std::size_t nextWriteIndex,
+                       const std::stop_token &token = {}) noexcept {
+    add_stall(writer_.monitor_);
+    DRO_SPSC_PROBE(full_wait_begin, this);
+    bool ready{false};
+    if constexpr (parking_v) {
+      // Wakes the parked producer, which then sees the stop request
+      std::stop_callback callback(token, [this] {
+        park_.writerSignal_.fetch_add(1, std::memory_order_release);
+        details::unpark(park_.writerSignal_);
+      });
+      ready = park_wait(
+          writer_.waitNs_, park_.writerSignal_, park_.writerParked_,
+          [&] { return refresh_read_index(nextWriteIndex); },
+          [&] { return stop_remaining(token); });
+    } else {
+      while (!(ready = refresh_read_index(nextWriteIndex)) &&
+             !token.stop_requested()) {
+        backoff();
+      }
+    }
+    DRO_SPSC_PROBE(full_wait_end, this);
+    return ready;
+  }
+
+  // Returns false if stop was requested before an element was written
+  bool wait_write_index(const std::size_t readIndex,
+                        const std::stop_token &token = {}) noexcept {
+    add_stall(reader_.monitor_);
+    DRO_SPSC_PROBE(empty_wait_begin, this);
+    bool ready{false};
+    if constexpr (parking_v) {
+      park_.readerFrom_.store(readIndex, std::memory_order_relaxed);
+      park_.readerNeed_.store(1, std::memory_order_relaxed);
+      // Wakes the parked consumer, which then sees the stop request
+      std::stop_callback callback(token, [this] {
+        park_.readerSignal_.fetch_add(1, std::memory_order_release);
+        details::unpark(park_.readerSignal_);
+      });
+      ready = park_wait(
+          reader_.waitNs_, park_.readerSignal_, park_.readerParked_,
+          [&] { return refresh_write_index(readIndex); },
+          [&] { return stop_remaining(token); });
+    } else {
+      while (!(ready = refresh_write_index(readIndex)) &&
+             !token.stop_requested()) {
+        backoff();
+      }
+    }
+    DRO_SPSC_PROBE(empty_wait_end, this);
+    return ready;
+  }
+
+  // Parking time left for a wait bounded only by the stop token
+  [[nodiscard]] static std::chrono::nanoseconds
+  stop_remaining(const std::stop_token &token) noexcept {
+    return token.stop_requested() ? std::chrono::nanoseconds::zero()
+                                  : std::chrono::nanoseconds::max();
+  }
+
+  template <typename WaitClock, typename Duration>
+  void wait_available(
+      const std::size_t readIndex, const std::size_t minCount,
+      const std::chrono::time_point<WaitClock, Duration> &deadline) noexcept {
+    // Polls the writer directly, the cache may hold a watermark limit
+    auto available = [&] {
+      return distance(readIndex, writer_.writeIndex_.load(acquire_v));
+    };
+    if (available() >= minCount) {
+      return;
+    }
+    add_stall(reader_.monitor_);
+    DRO_SPSC_PROBE(empty_wait_begin, this);
+    if constexpr (parking_v) {
+      // The producer only wakes the consumer once minCount are ready
+      park_.readerFrom_.store(readIndex, std::memory_order_relaxed);
+      park_.readerNeed_.store(minCount, std::memory_order_relaxed);
+      static_cast<void>(park_wait(
+          reader_.waitNs_, park_.readerSignal_, park_.readerParked_,
+          [&] { return available() >= minCount; },
+          [&] {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                deadline - WaitClock::now());
+          }));
+    } else {
+      while (available() < minCount && WaitClock::now() < deadline) {
+        backoff();
+      }
+    }
+    DRO_SPSC_PROBE(empty_wait_end, this);
+  }
+
+  [[nodiscard]] std::size_t load_write_index() const noexcept {
+    if constexpr (batched_v) {
+      return writer_.pendingIndex_;
+    } else {
+      return writer_.writeIndex_.load(std::memory_order_relaxed);
+    }
+  }
+
+  void add_stall(details::MonitorCacheLine *monitor) noexcept {
+    if constexpr (Traits::enable_stats) {
+      monitor->add_stall();
+    }
+  }
+
+  void add_dropped(const std::uint64_t count) noexcept {
+    if constexpr (Traits::enable_stats) {
+      writer_.monitor_->add_dropped(count);
+    }
+  }
+
+  // Written elements excluding drops, the producer's position in the buffer
+  [[nodiscard]] std::uint64_t written_sequence() const noexcept {
+    return (writer_.writeLaps_ * base_type::capacity_) + load_write_index();
+  }
+
+  // FullPolicy::Drop. A refused element still takes a sequence number, so
+  // the consumer sees the gap once it reaches the refusal.
+  template <typename... Args>
+  [[nodiscard]] bool drop_emplace(Args &&...args) noexcept(
+      details::SPSC_NoThrow_Type<T, Args &&...>) {
+    if (try_emplace(std::forward<Args>(args)...)) {
+      return true;
+    }
+    ++writer_.refusedCount_;
+    writer_.lastRefusedWrite_ = written_sequence();
+    // Single writer, the position is stored first so it is never older than
+    // the count the consumer loads
+    slowPath_.refusedWrite_.store(writer_.lastRefusedWrite_,
+                                  std::memory_order_relaxed);
+    slowPath_.refused_.store(writer_.refusedCount_, std::memory_order_release);
+    add_dropped(1);
+    publish_write_sequence();
+    return false;
+  }
+
+  void publish_write_sequence() noexcept {
+    if constexpr (Traits::enable_stats) {
+      writer_.monitor_->publish(last_write_sequence());
+    }
+  }
+
+  void publish_read_sequence() noexcept {
+    if constexpr (Traits::enable_stats) {
+      reader_.monitor_->publish(last_read_sequence());
+    }
+  }
+
+  void backoff() noexcept {
+    if constexpr (Traits::wait_policy == WaitPolicy::Yield) {
+      std::this_thread::yield();
+    }
+  }
+
+  // Spins for twice the moving average wait, then parks until ready() or the
+  // remaining() time runs out. Returns false on timeout.
+  template <typename Ready, typename Remaining>
+  [[nodiscard]] bool park_wait(std::int64_t &waitNs,
+                               std::atomic<std::uint32_t> &signal,
+                               std::atomic<bool> &parked, Ready &&ready,
+                               Remaining &&remaining) noexcept {
+    const auto start = std::chrono::steady_clock::now();
+    // Waits longer than parking costs go straight to parking
+    const std::chrono::nanoseconds budget{
+        (waitNs <= details::PARK_SPIN_LIMIT_NS) ? 2 * waitNs : 0};
+    bool isReady{ready()};
+    while (!isReady && std::chrono::steady_clock::now() - start < budget &&
+           remaining().count() > 0) {
+      isReady = ready();
+    }
+    if (!isReady) {
+      parked.store(true, std::memory_order_release);
+      while (true) {
+        const auto value = signal.load(std::memory_order_acquire);
+        // Pairs with the fence in wake_reader and wake_writer, so either this
+        // side sees the publish or the other side sees the parked flag
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto timeout = remaining();
+        if ((isReady = ready()) || timeout.count() <= 0) {
+          break;
+        }
+        details::park(signal, value, timeout);
+      }
+      parked.store(false, std::memory_order_relaxed);
+    }
+    // Saturates so a long idle period is forgotten after a few short waits
+    const auto waited = std::min<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count(),
+        2 * details::PARK_SPIN_LIMIT_NS);
+    waitNs += (waited - waitNs) / 8;
+    return isReady;
+  }
+
+  void publish_write_index(const std::size_t writeIndex) noexcept {
+    writer_.writeIndex_.store(writeIndex, release_v);
+    if constexpr (parking_v) {
+      wake_reader(writeIndex);
+    }
+  }
+
+  void publish_read_index(const std::size_t readIndex) noexcept {
+    reader_.readIndex_.store(readIndex, release_v);
+    if constexpr (parking_v) {
+      wake_writer();
+    }
+  }
+
+  void wake_reader(const std::size_t writeIndex) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Acquire pairs with the parked store to read the current threshold
+    if (park_.readerParked_.load(std::memory_order_acquire) &&
+        distance(park_.readerFrom_.load(std::memory_order_relaxed),
+                 writeIndex) >=
+            park_.readerNeed_.load(std::memory_order_relaxed)) [[unlikely]] {
+      park_.readerSignal_.fetch_add(1, std::memory_order_release);
+      details::unpark(park_.readerSignal_);
+    }
+  }
+
+  void wake_writer() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (park_.writerParked_.load(std::memory_order_relaxed)) [[unlikely]] {
+      park_.writerSignal_.fetch_add(1, std::memory_order_release);
+      details::unpark(park_.writerSignal_);
+    }
+  }
+
+  // Lap counts derive the 64-bit sequences without extra shared writes
+  void store_write_index(const std::size_t nextWriteIndex) noexcept {
+    writer_.writeLaps_ += static_cast<std::uint64_t>(nextWriteIndex == 0);
+    if constexpr (batched_v) {
+      writer_.pendingIndex_ = nextWriteIndex;
+      if (++writer_.pendingCount_ >= writer_.batchLimit_) {
+        flush();
+      }
+    } else {
+      publish_write_index(nextWriteIndex);
+    }
+    if (!(nextWriteIndex & (details::MONITOR_INTERVAL - 1))) [[unlikely]] {
+      publish_write_sequence();
+    }
+  }
+
+  void store_read_index(const std::size_t nextReadIndex) noexcept {
+    reader_.readLaps_ += static_cast<std::uint64_t>(nextReadIndex == 0);
+    publish_read_index(nextReadIndex);
+    if (!(nextReadIndex & (details::MONITOR_INTERVAL - 1))) [[unlikely]] {
+      publish_read_sequence();
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  advance_read_index(const std::size_t readIndex,
+                     const std::size_t count) noexcept {
+    const auto nextReadIndex = wrap_index(readIndex + count);
+    reader_.readLaps_ += static_cast<std::uint64_t>(nextReadIndex < readIndex);
+    return nextReadIndex;
+  }
+
+  [[nodiscard]] std::size_t distance(const std::size_t from,
+                                     const std::size_t to) const noexcept {
+    return (to >= from) ? to - from : (base_type::capacity_ - from) + to;
+  }
+
+  [[nodiscard]] std::size_t wrap_index(const std::size_t index) const noexcept {
+    return (index >= base_type::capacity_) ? index - base_type::capacity_
+                                           : index;
+  }
+
+  void write_stamp(const auto &writeIndex) noexcept {
+    if constexpr (timestamped_v) {
+      stamps_.stamps_[writeIndex] = Clock::now();
+    }
+  }
+
   // Note: The "+ padding" is a constant offset used to prevent false sharing
   // with memory in front of the SPSC allocations
   T &read_value(const auto &readIndex) noexcept(nothrow_v)
@@ -0,0 +1,126 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <cassert>    // for assert
+#include <filesystem> // for std::filesystem
+#include <fstream>    // for std::ofstream
+#include <iostream>   // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept>  // for std::invalid_argument
+#include <string>     // for std::string, to_string
+
+#include <unistd.h> // for getpid
+
+#include <dro/affinity.hpp> // for dro::CpuTopology, dro::pin_thread
+
+namespace fs = std::filesystem;
+
+void writeFile(const fs::path &path, const std::string &contents) {
+  fs::create_directories(path.parent_path());
+  std::ofstream(path) << contents << '\n';
+}
+
+// Two cores with two hyper-threads each, a private L2 per core and a shared L3
+void writeTopology(const fs::path &root) {
+  writeFile(root / "online", "0-3");
+  for (int cpu{}; cpu < 4; ++cpu) {
+    const auto dir = root / ("cpu" + std::to_string(cpu));
+    const std::string siblings = (cpu % 2) ? "1,3" : "0,2";
+    writeFile(dir / "topology" / "core_id", std::to_string(cpu % 2));
+    writeFile(dir / "topology" / "physical_package_id", "0");
+    writeFile(dir / "topology" / "thread_siblings_list", siblings);
+    writeFile(dir / "cache" / "index0" / "level", "1");
+    writeFile(dir / "cache" / "index0" / "type", "Instruction");
+    writeFile(dir / "cache" / "index0" / "shared_cpu_list", siblings);
+    writeFile(dir / "cache" / "index2" / "level", "2");
+    writeFile(dir / "cache" / "index2" / "type", "Unified");
+    writeFile(dir / "cache" / "index2" / "shared_cpu_list", siblings);
+    writeFile(dir / "cache" / "index3" / "level", "3");
+    writeFile(dir / "cache" / "index3" / "type", "Unified");
+    writeFile(dir / "cache" / "index3" / "shared_cpu_list", "0-3");
+    fs::create_directories(dir / "node0");
+  }
+}
+
+int main(int argc, char *argv[]) {
+
+  // Cpu List Parsing
+  {
+    auto cpus = dro::details::parse_cpu_list("0-2,5,7-8");
+    assert((cpus == std::vector<int>{0, 1, 2, 5, 7, 8}));
+    assert(dro::details::parse_cpu_list("3").size() == 1);
+    try {
+      auto invalid = dro::details::parse_cpu_list("3-1");
+      assert(false); // Should never be called
+    } catch (std::invalid_argument &e) {
+      assert(true); // Should always be called
+    }
+  }
+
+  // Topology From Sysfs
+  {
+    const auto root =
+        fs::temp_directory_path() / ("dro-cpu-" + std::to_string(getpid()));
+    writeTopology(root);
+    dro::CpuTopology topology(root, {0, 1, 2, 3});
+    assert(topology.cpus().size() == 4);
+    assert(topology.find(3)->core_ == 1);
+    assert(topology.find(3)->numaNode_ == 0);
+    assert(topology.share_core(1, 3));
+    assert(!topology.share_core(1, 2));
+    assert(topology.share_l2(0, 2));
+    assert(!topology.share_l2(0, 1));
+    assert(topology.share_l3(0, 1));
+    // Shares the L3 but not a physical core, preferring higher cores
+    auto pair = topology.recommend_pair();
+    assert(pair);
+    assert(pair->first == 2 && pair->second == 3);
+    fs::remove_all(root);
+  }
+
+  // Topology Limited To Allowed Cpus
+  {
+    const auto root =
+        fs::temp_directory_path() / ("dro-cpu-" + std::to_string(getpid()));
+    writeTopology(root);
+    // e.g. taskset -c 0,1,2
+    dro::CpuTopology topology(root, {0, 1, 2});
+    assert(topology.cpus().size() == 3);
+    assert(!topology.find(3));
+    auto pair = topology.recommend_pair();
+    assert(pair);
+    assert(pair->first == 1 && pair->second == 2);
+    dro::CpuTopology single(root, {2});
+    assert(!single.recommend_pair());
+    fs::remove_all(root);
+  }
+
+  // Allowed Cpus
+  {
+    const auto allowed = dro::allowed_cpus();
+    assert(!allowed.empty());
+    dro::pin_thread(allowed.front());
+  }
+
+  // Thread Pinning
+  {
+    dro::pin_thread(-1);
+    try {
+      dro::pin_thread(CPU_SETSIZE);
+      assert(false); // Should never be called
+    } catch (std::invalid_argument &e) {
+      assert(true); // Should always be called
+    }
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
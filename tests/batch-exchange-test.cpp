@@ -0,0 +1,109 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <cassert>  // for assert
+#include <cstddef>  // for size_t
+#include <iostream> // for operator<<, basic_ostream, char_traits, cout
+#include <set>      // for std::set
+#include <thread>   // for std::thread
+#include <vector>   // for std::vector
+
+#include <dro/batch-exchange.hpp> // for dro::BatchExchange
+
+struct BatchTraits : dro::SPSCTraits {
+  static constexpr auto wait_policy = dro::WaitPolicy::Yield;
+  static constexpr std::size_t publish_batch = 4;
+};
+
+int main(int argc, char *argv[]) {
+
+  // Construction Leaves No Trace in the Queue
+  {
+    dro::BatchExchange<int> exchange(2, 128);
+    const auto snapshot = exchange.monitor_snapshot();
+    assert(!snapshot.writeSequence_ && !snapshot.readSequence_);
+    assert(!snapshot.fullStalls_ && !snapshot.emptyStalls_);
+    assert(exchange.try_consume() == nullptr);
+    auto &batch = exchange.acquire();
+    assert(batch.empty() && batch.capacity() >= 128);
+  }
+
+  // Buffers Are Reused
+  {
+    dro::BatchExchange<int> exchange(2, 128);
+    assert(exchange.batches() == 2);
+    assert(exchange.rows() == 128);
+    std::set<const int *> buffers;
+    for (int round{}; round < 10; ++round) {
+      auto &batch = exchange.acquire();
+      assert(batch.empty() && batch.capacity() >= 128);
+      for (int row{}; row < 128; ++row) {
+        batch.push_back(row + round);
+      }
+      buffers.insert(batch.data());
+      exchange.publish();
+
+      auto &consumed = exchange.consume();
+      assert(consumed.size() == 128 && consumed.front() == round);
+      exchange.release();
+    }
+    // Never allocated past the preallocated slots
+    assert(buffers.size() <= 3);
+  }
+
+  // Every Batch With The Consumer
+  {
+    dro::BatchExchange<int> exchange(2, 4);
+    for (int i{}; i < 2; ++i) {
+      auto *batch = exchange.try_acquire();
+      assert(batch);
+      batch->push_back(i);
+      exchange.publish();
+    }
+    assert(exchange.try_acquire() == nullptr);
+    auto *batch = exchange.try_consume();
+    assert(batch && batch->front() == 0);
+    exchange.release();
+    assert(exchange.try_acquire() != nullptr);
+  }
+
+  // Producer And Consumer Threads
+  {
+    const int batches{200};
+    const int rows{1'000};
+    dro::BatchExchange<int, BatchTraits> exchange(3, rows);
+    auto thrd = std::thread([&] {
+      for (int i{}; i < batches; ++i) {
+        auto &batch = exchange.acquire();
+        for (int row{}; row < rows; ++row) {
+          batch.push_back((i * rows) + row);
+        }
+        exchange.publish();
+      }
+    });
+    int expected{};
+    for (int i{}; i < batches; ++i) {
+      auto &batch = exchange.consume();
+      assert(batch.size() == static_cast<std::size_t>(rows));
+      for (const int val : batch) {
+        assert(val == expected);
+        ++expected;
+      }
+      exchange.release();
+    }
+    thrd.join();
+    assert(exchange.try_consume() == nullptr);
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
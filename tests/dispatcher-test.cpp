@@ -0,0 +1,131 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <cassert>   // for assert
+#include <cstddef>   // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for std::logic_error
+#include <thread>    // for std::thread
+#include <vector>    // for std::vector
+
+#include <dro/dispatcher.hpp> // for dro::Dispatcher, dro::DispatchPolicy
+
+int main(int argc, char *argv[]) {
+
+  // Round Robin
+  {
+    dro::Dispatcher<int> dispatcher(3, 4);
+    for (int i{}; i < 6; ++i) {
+      assert(dispatcher.dispatch(i) == static_cast<std::size_t>(i % 3));
+    }
+    for (std::size_t worker{}; worker < 3; ++worker) {
+      auto &inbox = dispatcher.inbox(worker);
+      assert(inbox.size() == 2);
+      int val{};
+      inbox.pop(val);
+      assert(val == static_cast<int>(worker));
+    }
+  }
+
+  // Least Loaded
+  {
+    dro::Dispatcher<int> dispatcher(2, 4, dro::DispatchPolicy::LeastLoaded);
+    // Equal depths rotate through the workers
+    for (int i{}; i < 8; ++i) {
+      assert(dispatcher.dispatch(i) == static_cast<std::size_t>(i % 2));
+    }
+    assert(!dispatcher.try_dispatch(8));
+
+    // Only worker 1 drains, which the dispatcher sees once every inbox
+    // appears full
+    int val{};
+    for (int i{}; i < 3; ++i) {
+      dispatcher.inbox(1).pop(val);
+    }
+    for (int i{}; i < 3; ++i) {
+      assert(dispatcher.dispatch(i) == 1);
+    }
+    assert(!dispatcher.try_dispatch(9));
+    assert(dispatcher.inbox(0).size() == 4);
+    assert(dispatcher.inbox(1).size() == 4);
+  }
+
+  // Completion Queues
+  {
+    const std::size_t workers{4};
+    const int count{10'000};
+    dro::Dispatcher<int> dispatcher(workers, 16,
+                                    dro::DispatchPolicy::LeastLoaded, 16);
+    std::vector<std::thread> threads;
+    for (std::size_t worker{}; worker < workers; ++worker) {
+      threads.emplace_back([&dispatcher, worker] {
+        auto &inbox = dispatcher.inbox(worker);
+        auto &completions = dispatcher.completions(worker);
+        int task{};
+        while (true) {
+          inbox.pop(task);
+          if (task < 0) {
+            break;
+          }
+          completions.push(task * 2);
+        }
+      });
+    }
+
+    long long sum{};
+    int completed{};
+    auto collect = [&](std::size_t, int result) {
+      sum += result;
+      ++completed;
+    };
+    for (int i{}; i < count;) {
+      // Never blocks, so the workers can always push their results
+      if (dispatcher.try_dispatch(i)) {
+        ++i;
+      }
+      dispatcher.poll_completions(collect);
+    }
+    while (completed < count) {
+      dispatcher.poll_completions(collect);
+    }
+    for (std::size_t worker{}; worker < workers; ++worker) {
+      dispatcher.inbox(worker).push(-1);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    assert(sum == static_cast<long long>(count) * (count - 1));
+  }
+
+  // Invalid Arguments
+  {
+    bool thrown{false};
+    try {
+      dro::Dispatcher<int> dispatcher(0, 4);
+    } catch (const std::logic_error &) {
+      thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    dro::Dispatcher<int> dispatcher(2, 4);
+    try {
+      static_cast<void>(dispatcher.completions(0));
+    } catch (const std::logic_error &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
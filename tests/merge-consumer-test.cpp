@@ -0,0 +1,181 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <cassert>   // for assert
+#include <chrono>    // for milliseconds, steady_clock
+#include <cstddef>   // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <memory>    // for std::unique_ptr, std::make_unique
+#include <stdexcept> // for std::logic_error
+#include <thread>    // for std::thread
+#include <vector>    // for std::vector
+
+#include <dro/merge-consumer.hpp> // for dro::MergeConsumer
+#include <dro/spsc-queue.hpp>     // for dro::SPSCQueue
+
+struct Event {
+  long timestamp_{};
+  int source_{};
+};
+
+struct EventTime {
+  long operator()(const Event &event) const noexcept {
+    return event.timestamp_;
+  }
+};
+
+using Queue = dro::SPSCQueue<Event>;
+using Merge = dro::MergeConsumer<Queue, EventTime>;
+
+int main(int argc, char *argv[]) {
+
+  // Merge In Timestamp Order
+  {
+    Queue first(8);
+    Queue second(8);
+    Queue third(8);
+    Merge merge({&first, &second, &third});
+    assert(merge.inputs() == 3);
+    for (const long timestamp : {1, 4, 7}) {
+      first.push(Event{timestamp, 0});
+    }
+    for (const long timestamp : {2, 4, 8}) {
+      second.push(Event{timestamp, 1});
+    }
+    for (const long timestamp : {3, 6, 9}) {
+      third.push(Event{timestamp, 2});
+    }
+    // Ties are emitted in input order
+    const std::vector<Event> expected{{1, 0}, {2, 1}, {3, 2}, {4, 0}, {4, 1},
+                                      {6, 2}, {7, 0}};
+    Event event;
+    for (const auto &next : expected) {
+      assert(merge.try_pop(event));
+      assert(event.timestamp_ == next.timestamp_);
+      assert(event.source_ == next.source_);
+    }
+    // The first input is empty, so the next event is unknown
+    assert(!merge.try_pop(event));
+    first.push(Event{10, 0});
+    assert(merge.try_pop(event));
+    assert(event.timestamp_ == 8);
+    // Now the second input is empty
+    assert(!merge.try_pop(event));
+  }
+
+  // Bounded Wait For Lagging Inputs
+  {
+    Queue first(8);
+    Queue second(8);
+    Merge merge({&first, &second});
+    Event event;
+    const auto start = std::chrono::steady_clock::now();
+    assert(!merge.pop(event, std::chrono::milliseconds(1)));
+    first.push(Event{5, 0});
+    // The second input has lagged since the first pop
+    assert(merge.pop(event, std::chrono::milliseconds(2)));
+    assert(std::chrono::steady_clock::now() - start >=
+           std::chrono::milliseconds(2));
+    assert(event.timestamp_ == 5);
+
+    // A lagging input that catches up within the wait keeps the order
+    first.push(Event{7, 0});
+    auto thrd = std::thread([&] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      second.push(Event{6, 1});
+    });
+    assert(merge.pop(event, std::chrono::seconds(10)));
+    assert(event.timestamp_ == 6);
+    thrd.join();
+  }
+
+  // A Silent Input Delays Only the First Pop
+  {
+    Queue first(8);
+    Queue silent(8);
+    Merge merge({&first, &silent});
+    const auto maxWait = std::chrono::milliseconds(50);
+    for (const long timestamp : {1, 2, 3, 4}) {
+      first.push(Event{timestamp, 0});
+    }
+    Event event;
+    auto start = std::chrono::steady_clock::now();
+    assert(merge.pop(event, maxWait));
+    assert(std::chrono::steady_clock::now() - start >= maxWait);
+    for (const long timestamp : {2, 3, 4}) {
+      assert(merge.pop(event, maxWait));
+      assert(event.timestamp_ == timestamp);
+    }
+
+    // Once the input delivers and empties again, a new wait starts
+    silent.push(Event{5, 1});
+    first.push(Event{6, 0});
+    assert(merge.pop(event, maxWait));
+    assert(event.timestamp_ == 5);
+    start = std::chrono::steady_clock::now();
+    assert(merge.pop(event, maxWait));
+    assert(event.timestamp_ == 6);
+    assert(std::chrono::steady_clock::now() - start >= maxWait);
+  }
+
+  // Feed Handler Threads
+  {
+    const int inputs{4};
+    const long count{10'000};
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<Queue *> pointers;
+    for (int i{}; i < inputs; ++i) {
+      queues.push_back(std::make_unique<Queue>(64));
+      pointers.push_back(queues.back().get());
+    }
+    Merge merge(pointers);
+    std::vector<std::thread> threads;
+    for (int source{}; source < inputs; ++source) {
+      threads.emplace_back([&, source] {
+        // Interleaved timestamps, each source increasing
+        for (long i{}; i < count; ++i) {
+          queues[source]->push(Event{(i * inputs) + source, source});
+        }
+      });
+    }
+    Event event;
+    long next{};
+    for (; next < (count - 1) * inputs; ++next) {
+      while (!merge.try_pop(event)) {
+      }
+      assert(event.timestamp_ == next);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    // Inputs that finished stay empty, so the tail needs no wait
+    for (; next < count * inputs; ++next) {
+      assert(merge.pop(event, std::chrono::milliseconds(0)));
+      assert(event.timestamp_ == next);
+    }
+    assert(!merge.pop(event, std::chrono::milliseconds(0)));
+  }
+
+  // Invalid Arguments
+  {
+    bool thrown{false};
+    try {
+      Merge merge({});
+    } catch (const std::logic_error &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
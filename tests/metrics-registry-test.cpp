@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <cassert>      // for assert
+#include <cerrno>       // for EEXIST
+#include <iostream>     // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept>    // for std::overflow_error
+#include <string>       // for std::string, to_string
+#include <system_error> // for std::system_error
+
+#include <fcntl.h>    // for O_CREAT, O_RDWR
+#include <sys/mman.h> // for shm_open
+#include <unistd.h>   // for getpid, close
+
+#include <dro/metrics-registry.hpp> // for dro::MetricsRegistry
+#include <dro/spsc-queue.hpp>       // for dro::SPSCQueue
+
+int main(int argc, char *argv[]) {
+  const std::string name = "/dro-spsc-test-" + std::to_string(getpid());
+
+  // Registered Queues Are Visible to a Reader
+  {
+    dro::MetricsRegistry registry(name, 2);
+    dro::SPSCQueue<int> queue(2'048);
+    int val{};
+    // Statistics recorded before registration are carried over
+    assert(!queue.try_pop(val));
+    auto registration = registry.add("orders", queue);
+    for (int i{}; i < 1'024; ++i) {
+      queue.push(i);
+    }
+    queue.pop(val);
+    assert(!queue.monitor_snapshot().fullStalls_);
+
+    dro::MetricsReader reader(name);
+    int count{};
+    reader.for_each([&](const dro::MetricsReader::QueueMetrics &metrics) {
+      ++count;
+      assert(metrics.name_ == "orders");
+      assert(metrics.capacity_ == 2'048);
+      assert(metrics.snapshot_.writeSequence_ == 1'024);
+      assert(metrics.snapshot_.emptyStalls_ == 1);
+    });
+    assert(count == 1);
+
+    // Full registry throws, and a released slot is reused
+    dro::SPSCQueue<int> second(10);
+    dro::SPSCQueue<int> third(10);
+    {
+      auto secondRegistration = registry.add("second", second);
+      try {
+        auto thirdRegistration = registry.add("third", third);
+        assert(false); // Should never be called
+      } catch (std::overflow_error &e) {
+        assert(true); // Should always be called
+      }
+    }
+    auto thirdRegistration = registry.add("third", third);
+    count = 0;
+    reader.for_each(
+        [&](const dro::MetricsReader::QueueMetrics &metrics) { ++count; });
+    assert(count == 2);
+    // Replacing or destroying a registration detaches the queue
+    third.push(1);
+    thirdRegistration = dro::MetricsRegistration();
+    third.push(2);
+    assert(third.monitor_snapshot().writeSequence_ == 1);
+    second.push(1);
+    {
+      auto secondRegistration = registry.add("second", second);
+      second.push(2);
+    }
+    // Detaching publishes the latest sequence to the queue's own storage
+    second.push(3);
+    assert(second.monitor_snapshot().writeSequence_ == 2);
+    count = 0;
+    reader.for_each(
+        [&](const dro::MetricsReader::QueueMetrics &metrics) { ++count; });
+    assert(count == 1);
+  }
+
+  // Existing Segment Is Not Taken Over
+  {
+    dro::MetricsRegistry registry(name, 2);
+    try {
+      dro::MetricsRegistry duplicate(name, 2);
+      assert(false); // Should never be called
+    } catch (std::system_error &e) {
+      assert(e.code().value() == EEXIST);
+    }
+    // The owner's segment is untouched
+    dro::MetricsReader reader(name);
+  }
+
+  // Stale Segment Is Reclaimed on Request
+  {
+    // Left behind by a crashed process
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    assert(fd != -1);
+    close(fd);
+    try {
+      dro::MetricsRegistry registry(name, 2);
+      assert(false); // Should never be called
+    } catch (std::system_error &e) {
+      assert(true); // Should always be called
+    }
+    dro::MetricsRegistry registry(name, 2, true);
+    dro::MetricsReader reader(name);
+  }
+
+  // Reader Rejects a Missing Segment
+  {
+    try {
+      dro::MetricsReader reader(name);
+      assert(false); // Should never be called
+    } catch (std::system_error &e) {
+      assert(true); // Should always be called
+    }
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <cassert>   // for assert
+#include <cstddef>   // for size_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <stdexcept> // for std::logic_error
+#include <thread>    // for std::thread, std::this_thread::yield
+#include <vector>    // for std::vector
+
+#include <dro/parallel-stage.hpp> // for dro::ParallelStage
+
+int main(int argc, char *argv[]) {
+
+  // Outputs Completed Out Of Order
+  {
+    dro::ParallelStage<int, int> stage(3, 4);
+    for (int i{}; i < 9; ++i) {
+      stage.emplace(i);
+    }
+    for (std::size_t worker{}; worker < 3; ++worker) {
+      assert(stage.inbox(worker).size() == 3);
+    }
+    // Workers finish in reverse order
+    int val{};
+    for (std::size_t worker{3}; worker-- > 0;) {
+      int input{};
+      while (stage.inbox(worker).try_pop(input)) {
+        stage.outbox(worker).push(input * 10);
+      }
+      if (worker) {
+        assert(!stage.try_pop(val));
+      }
+    }
+    for (int i{}; i < 9; ++i) {
+      assert(stage.try_pop(val));
+      assert(val == i * 10);
+    }
+    assert(!stage.try_pop(val));
+  }
+
+  // Reorder Window
+  {
+    dro::ParallelStage<int, int> stage(2, 4, 2);
+    assert(stage.window() == 2);
+    for (int i{}; i < 4; ++i) {
+      assert(stage.try_emplace(i));
+    }
+    int input{};
+    while (stage.inbox(1).try_pop(input)) {
+      stage.outbox(1).push(input);
+    }
+    int val{};
+    assert(!stage.try_pop(val));
+    // Output 1 fits in the window, output 3 stays in the outbox
+    assert(stage.outbox(1).size() == 1);
+    while (stage.inbox(0).try_pop(input)) {
+      stage.outbox(0).push(input);
+    }
+    for (int i{}; i < 4; ++i) {
+      stage.pop(val);
+      assert(val == i);
+    }
+  }
+
+  // Producer, Workers, and Consumer Threads
+  {
+    const std::size_t workers{4};
+    const int count{20'000};
+    dro::ParallelStage<int, long long> stage(workers, 64);
+    std::vector<std::thread> threads;
+    for (std::size_t worker{}; worker < workers; ++worker) {
+      threads.emplace_back([&stage, worker] {
+        int input{};
+        while (true) {
+          stage.inbox(worker).pop(input);
+          // Uneven work so workers fall behind each other
+          if (input % 97 == static_cast<int>(worker)) {
+            std::this_thread::yield();
+          }
+          stage.outbox(worker).push(static_cast<long long>(input) * input);
+          if (input < 0) {
+            break;
+          }
+        }
+      });
+    }
+    auto producer = std::thread([&stage] {
+      for (int i{}; i < count; ++i) {
+        stage.emplace(i);
+      }
+      for (std::size_t worker{}; worker < workers; ++worker) {
+        stage.emplace(-1);
+      }
+    });
+    long long val{};
+    for (int i{}; i < count; ++i) {
+      stage.pop(val);
+      assert(val == static_cast<long long>(i) * i);
+    }
+    for (std::size_t worker{}; worker < workers; ++worker) {
+      stage.pop(val);
+    }
+    producer.join();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  // Invalid Arguments
+  {
+    bool thrown{false};
+    try {
+      dro::ParallelStage<int, int> stage(0, 4);
+    } catch (const std::logic_error &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
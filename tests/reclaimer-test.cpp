@@ -0,0 +1,124 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <atomic>    // for std::atomic
+#include <cassert>   // for assert
+#include <chrono>    // for seconds, milliseconds, steady_clock
+#include <cstddef>   // for size_t
+#include <cstdint>   // for uint64_t
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <memory>    // for std::unique_ptr, std::make_unique
+#include <stdexcept> // for std::logic_error
+#include <thread>    // for std::thread, std::this_thread::get_id
+#include <vector>    // for std::vector
+
+#include <dro/reclaimer.hpp> // for dro::Reclaimer
+
+std::atomic<int> destroyed{0};
+std::atomic<int> destroyedOnHot{0};
+thread_local bool hotThread{false};
+
+struct OrderBook {
+  std::vector<int> levels_ = std::vector<int>(1'024);
+  ~OrderBook() {
+    destroyed.fetch_add(1);
+    if (hotThread) {
+      destroyedOnHot.fetch_add(1);
+    }
+  }
+};
+
+int main(int argc, char *argv[]) {
+
+  // Destroyed Off The Hot Threads
+  {
+    const int count{1'000};
+    std::uint64_t inlineDeletes{};
+    {
+      dro::Reclaimer reclaimer(2, 64);
+      assert(reclaimer.threads() == 2);
+      std::vector<std::thread> threads;
+      for (std::size_t slot{}; slot < 2; ++slot) {
+        threads.emplace_back([&reclaimer, slot] {
+          hotThread = true;
+          for (int i{}; i < count; ++i) {
+            reclaimer.retire(slot, std::make_unique<OrderBook>());
+            if (i % 32 == 0) {
+              std::this_thread::yield();
+            }
+          }
+        });
+      }
+      for (auto &thread : threads) {
+        thread.join();
+      }
+      inlineDeletes = reclaimer.inline_deletes();
+    }
+    assert(destroyed == 2 * count);
+    // Only overflows are destroyed on the hot threads
+    assert(static_cast<std::uint64_t>(destroyedOnHot) == inlineDeletes);
+  }
+
+  // Type Erased Deleter And Arrays
+  {
+    destroyed = 0;
+    destroyedOnHot = 0;
+    static std::atomic<int> freed{0};
+    {
+      dro::Reclaimer reclaimer(1, 8);
+      reclaimer.retire(0, std::make_unique<OrderBook[]>(3));
+      reclaimer.retire(0, new int(5), [](void *ptr) {
+        delete static_cast<int *>(ptr);
+        freed.fetch_add(1);
+      });
+      reclaimer.retire(0, std::unique_ptr<OrderBook>());
+    }
+    assert(destroyed == 3);
+    assert(freed == 1);
+  }
+
+  // Full Retire Queue
+  {
+    destroyed = 0;
+    destroyedOnHot = 0;
+    hotThread = true;
+    const auto start = std::chrono::steady_clock::now();
+    {
+      // The reclaimer thread sleeps far longer than the test runs
+      dro::Reclaimer reclaimer(1, 2, std::chrono::seconds(30));
+      for (int i{}; i < 10; ++i) {
+        reclaimer.retire(0, std::make_unique<OrderBook>());
+      }
+      assert(reclaimer.inline_deletes() ==
+             static_cast<std::uint64_t>(destroyedOnHot));
+      assert(reclaimer.reclaimed() + reclaimer.inline_deletes() <= 10);
+    }
+    hotThread = false;
+    // The destructor wakes the reclaimer thread and drains the queue
+    assert(std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+    assert(destroyed == 10);
+  }
+
+  // Invalid Arguments
+  {
+    bool thrown{false};
+    try {
+      dro::Reclaimer reclaimer(0, 4);
+    } catch (const std::logic_error &) {
+      thrown = true;
+    }
+    assert(thrown);
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
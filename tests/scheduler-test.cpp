@@ -0,0 +1,172 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <cassert>   // for assert
+#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
+#include <memory>    // for std::unique_ptr
+#include <stdexcept> // for std::runtime_error
+#include <thread>    // for std::thread
+#include <vector>    // for std::vector
+
+#include <dro/scheduler.hpp> // for dro::Scheduler, dro::Stage, dro::StageQueue
+
+dro::Stage source(dro::StageQueue<int> &out, int count) {
+  for (int i{}; i < count; ++i) {
+    co_await dro::push(out, i);
+  }
+}
+
+dro::Stage doubler(dro::StageQueue<int> &in, dro::StageQueue<int> &out,
+                   int count) {
+  for (int i{}; i < count; ++i) {
+    int val{};
+    co_await dro::pop(in, val);
+    co_await dro::push(out, val * 2);
+  }
+}
+
+template <typename Queue>
+dro::Stage sink(Queue &in, std::vector<int> &results, int count) {
+  for (int i{}; i < count; ++i) {
+    int val{};
+    co_await dro::pop(in, val);
+    results.push_back(val);
+  }
+}
+
+dro::Stage pushOne(dro::StageQueue<int> &out, int val) {
+  co_await dro::push(out, val);
+}
+
+dro::Stage spawner(dro::Scheduler &scheduler, dro::StageQueue<int> &out,
+                   int count) {
+  // Each spawn may reallocate the stages the scheduler is iterating
+  for (int i{}; i < count; ++i) {
+    scheduler.spawn(pushOne(out, i));
+  }
+  co_return;
+}
+
+dro::Stage thrower(dro::StageQueue<int> &in) {
+  int val{};
+  co_await dro::pop(in, val);
+  throw std::runtime_error("Stage failed");
+}
+
+int main(int argc, char *argv[]) {
+
+  // Pipeline On One Thread
+  {
+    // Queues far smaller than the element count force stages to suspend
+    const int count{1'000};
+    dro::StageQueue<int> first(4);
+    dro::StageQueue<int> second(2);
+    std::vector<int> results;
+    dro::Scheduler scheduler;
+    // Spawned in reverse so downstream stages suspend on empty queues first
+    scheduler.spawn(sink(second, results, count));
+    scheduler.spawn(doubler(first, second, count));
+    scheduler.spawn(source(first, count));
+    assert(scheduler.run());
+    assert(scheduler.done());
+    assert(results.size() == count);
+    for (int i{}; i < count; ++i) {
+      assert(results[i] == i * 2);
+    }
+  }
+
+  // Move Only Elements
+  {
+    dro::StageQueue<std::unique_ptr<int>> queue(1);
+    int total{};
+    dro::Scheduler scheduler;
+    scheduler.spawn([](auto &queue) -> dro::Stage {
+      for (int i{}; i < 10; ++i) {
+        co_await dro::push(queue, std::make_unique<int>(i));
+      }
+    }(queue));
+    scheduler.spawn([](auto &queue, int &total) -> dro::Stage {
+      for (int i{}; i < 10; ++i) {
+        std::unique_ptr<int> val;
+        co_await dro::pop(queue, val);
+        total += *val;
+      }
+    }(queue, total));
+    assert(scheduler.run());
+    assert(total == 45);
+  }
+
+  // Deadlock Detection
+  {
+    dro::StageQueue<int> queue(4);
+    std::vector<int> results;
+    dro::Scheduler scheduler;
+    scheduler.spawn(sink(queue, results, 1));
+    assert(!scheduler.run());
+    assert(!scheduler.done());
+  }
+
+  // Stages Spawned From a Running Stage
+  {
+    const int count{64};
+    dro::StageQueue<int> queue(2);
+    std::vector<int> results;
+    dro::Scheduler scheduler;
+    // Stages after the spawner must still be resumed from the new storage
+    scheduler.spawn(spawner(scheduler, queue, count));
+    scheduler.spawn(sink(queue, results, count));
+    assert(scheduler.run());
+    assert(scheduler.done());
+    assert(results.size() == count);
+    int total{};
+    for (const int val : results) {
+      total += val;
+    }
+    assert(total == count * (count - 1) / 2);
+  }
+
+  // Input From Another Thread
+  {
+    const int count{100};
+    dro::SPSCQueue<int> queue(8);
+    std::vector<int> results;
+    dro::Scheduler scheduler;
+    scheduler.set_external(true);
+    scheduler.spawn(sink(queue, results, count));
+    auto thrd = std::thread([&] {
+      for (int i{}; i < count; ++i) {
+        queue.push(i);
+      }
+    });
+    assert(scheduler.run());
+    thrd.join();
+    assert(results.size() == count);
+    assert(results.back() == count - 1);
+  }
+
+  // Stage Exception
+  {
+    dro::StageQueue<int> queue(4);
+    queue.push(1);
+    dro::Scheduler scheduler;
+    scheduler.spawn(thrower(queue));
+    try {
+      scheduler.run();
+      assert(false); // Should never be called
+    } catch (std::runtime_error &e) {
+      assert(true); // Should always be called
+    }
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
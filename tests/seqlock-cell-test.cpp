@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <atomic>   // for std::atomic
+#include <cassert>  // for assert
+#include <iostream> // for operator<<, basic_ostream, char_traits, cout
+#include <thread>   // for std::thread
+
+#include <dro/seqlock-cell.hpp> // for dro::SeqLockCell
+
+int main(int argc, char *argv[]) {
+
+  // Functional Tests
+  {
+    dro::SeqLockCell<int> cell;
+    int val{-1};
+    assert(cell.load() == 0);
+    assert(cell.version() == 0);
+    cell.store(5);
+    assert(cell.try_load(val));
+    assert(val == 5);
+    assert(cell.version() == 1);
+    cell.store(6);
+    assert(cell.load() == 6);
+    assert(cell.version() == 2);
+  }
+
+  // Odd Sized Object
+  {
+    struct Test {
+      char x_[13];
+      double y_;
+    };
+    dro::SeqLockCell<Test> cell(Test{{'a'}, 1.5});
+    Test val = cell.load();
+    assert(val.x_[0] == 'a');
+    assert(val.y_ > 1.0 && val.y_ < 2.0);
+  }
+
+  // Readers Never Observe a Torn Value
+  {
+    struct Test {
+      long x_;
+      long y_;
+      long z_;
+    };
+    const long iters{100'000};
+    dro::SeqLockCell<Test> cell;
+    std::atomic<bool> done{false};
+    auto thrd = std::thread([&] {
+      while (!done.load(std::memory_order_acquire)) {
+        Test val = cell.load();
+        assert(val.y_ == val.x_ * 2);
+        assert(val.z_ == val.x_ * 3);
+      }
+    });
+    for (long i{}; i < iters; ++i) {
+      cell.store(Test{i, i * 2, i * 3});
+    }
+    done.store(true, std::memory_order_release);
+    thrd.join();
+    assert(cell.load().x_ == iters - 1);
+  }
+
+  std::cout << "Tests Completed!\n";
+  return 0;
+}
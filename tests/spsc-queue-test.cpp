@@ -10,12 +10,67 @@
 // The above copyright notice and this permission notice shall be included in
 // all copies or substantial portions of the Software.
 
-#include <cassert>   // for assert
-#include <iostream>  // for operator<<, basic_ostream, char_traits, cout
-#include <memory>    // for std::unique_ptr
-#include <stdexcept> // for std::logic_error
+#include <algorithm>  // for std::min
+#include <atomic>     // for std::atomic
+#include <cassert>    // for assert
+#include <chrono>     // for steady_clock, milliseconds, time_point
+#include <cstdint>    // for std::int64_t
+#include <iostream>   // for operator<<, basic_ostream, char_traits, cout
+#include <iterator>   // for std::back_inserter
+#include <memory>     // for std::unique_ptr
+#include <ratio>      // for std::nano
+#include <stdexcept>  // for std::logic_error
+#include <stop_token> // for std::stop_token, std::stop_source
+#include <thread>     // for std::thread, std::jthread, sleep_for
+#include <vector>     // for std::vector
 
-#include <dro/spsc-queue.hpp> // for dro::SPSCQueue
+#include <dro/spsc-queue.hpp> // for dro::SPSCQueue, dro::SPSCTraits
+
+// Advanced by hand so expiry tests do not depend on the scheduler
+struct ManualClock {
+  using rep = std::int64_t;
+  using period = std::nano;
+  using duration = std::chrono::nanoseconds;
+  using time_point = std::chrono::time_point<ManualClock>;
+  static constexpr bool is_steady = true;
+
+  static inline time_point now_{};
+
+  static time_point now() noexcept { return now_; }
+  static void advance(const duration elapsed) noexcept { now_ += elapsed; }
+};
+
+struct TimestampTraits : dro::SPSCTraits {
+  using clock_type = ManualClock;
+};
+
+struct DropTraits : dro::SPSCTraits {
+  static constexpr auto full_policy = dro::FullPolicy::Drop;
+  static constexpr bool enable_stats = false;
+};
+
+struct DropStatsTraits : dro::SPSCTraits {
+  static constexpr auto full_policy = dro::FullPolicy::Drop;
+};
+
+struct OverwriteTraits : dro::SPSCTraits {
+  static constexpr auto full_policy = dro::FullPolicy::Overwrite;
+};
+
+struct AdaptiveTraits : dro::SPSCTraits {
+  static constexpr std::size_t publish_batch = 4;
+  static constexpr bool adaptive_publish = true;
+};
+
+struct ParkTraits : dro::SPSCTraits {
+  static constexpr auto wait_policy = dro::WaitPolicy::Adaptive;
+};
+
+struct BatchTraits : dro::SPSCTraits {
+  static constexpr auto wait_policy = dro::WaitPolicy::Yield;
+  static constexpr std::size_t publish_batch = 4;
+  static constexpr std::size_t alignment = 128;
+};
 
 int main(int argc, char *argv[]) {
 
@@ -165,6 +220,658 @@ int main(int argc, char *argv[]) {
     assert(*val.get() == 1);
   }
 
+  // Timestamped Queue Expiry
+  {
+    const int size{10};
+    dro::SPSCQueue<int, 0, std::allocator<int>, TimestampTraits> queue{size};
+    int val{};
+    assert(!queue.pop_fresh(val, std::chrono::milliseconds(5)));
+    for (int i{}; i < 6; ++i) {
+      queue.emplace(i);
+    }
+    ManualClock::advance(std::chrono::milliseconds(10));
+    for (int i{6}; i < 8; ++i) {
+      queue.emplace(i);
+    }
+    assert(queue.pop_fresh(val, std::chrono::milliseconds(5)));
+    assert(val == 6);
+    assert(queue.expired() == 6);
+    assert(queue.size() == 1);
+    assert(queue.pop_fresh(val, std::chrono::hours(1)));
+    assert(val == 7);
+    assert(queue.empty());
+    // Wraps around the end of the buffer
+    for (int i{}; i < size; ++i) {
+      queue.emplace(i);
+    }
+    ManualClock::advance(std::chrono::milliseconds(10));
+    assert(!queue.pop_fresh(val, std::chrono::milliseconds(5)));
+    assert(queue.expired() == 16);
+    assert(queue.empty());
+    // Exactly maxAge old is still fresh
+    queue.emplace(1);
+    ManualClock::advance(std::chrono::milliseconds(5));
+    assert(queue.pop_fresh(val, std::chrono::milliseconds(5)));
+    assert(val == 1);
+    assert(queue.expired() == 16);
+    queue.emplace(2);
+    assert(queue.try_pop(val));
+    assert(val == 2);
+  }
+
+  // Stack Allocated Timestamped Queue
+  {
+    const int size{10};
+    dro::SPSCQueue<int, size, std::allocator<int>, TimestampTraits> queue;
+    int val{};
+    queue.push(1);
+    assert(queue.pop_fresh(val, std::chrono::hours(1)));
+    assert(val == 1);
+    assert(!queue.expired());
+  }
+
+  // Watermark Callbacks
+  {
+    const int size{10};
+    dro::SPSCQueue<int> queue{size};
+    int highCount{};
+    int lowCount{};
+    queue.set_watermarks(
+        8, 2, [&] { ++highCount; }, [&] { ++lowCount; });
+    int val{};
+    for (int i{}; i < 7; ++i) {
+      queue.emplace(i);
+    }
+    assert(!highCount);
+    queue.emplace(7);
+    assert(highCount == 1);
+    assert(queue.try_emplace(8));
+    assert(highCount == 1);
+    for (int i{}; i < 6; ++i) {
+      queue.pop(val);
+      assert(val == i);
+    }
+    assert(!lowCount);
+    queue.pop(val);
+    assert(lowCount == 1);
+    assert(queue.size() == 2);
+    // Crossing the high watermark again fires a second transition
+    for (int i{}; i < 6; ++i) {
+      queue.push(i);
+    }
+    assert(highCount == 2);
+    while (queue.try_pop(val)) {
+    }
+    assert(lowCount == 2);
+    // A low watermark of 0 fires once the queue drains
+    queue.set_watermarks(
+        8, 0, [&] { ++highCount; }, [&] { ++lowCount; });
+    highCount = 0;
+    lowCount = 0;
+    for (int cycle{1}; cycle <= 2; ++cycle) {
+      for (int i{}; i < 8; ++i) {
+        queue.push(i);
+      }
+      assert(highCount == cycle);
+      while (queue.try_pop(val)) {
+      }
+      assert(lowCount == cycle);
+    }
+    try {
+      queue.set_watermarks(2, 8, nullptr, nullptr);
+      assert(false); // Should never be called
+    } catch (std::invalid_argument &e) {
+      assert(true); // Should always be called
+    }
+  }
+
+  // Sequence Numbers
+  {
+    const int size{4};
+    dro::SPSCQueue<int> queue{size};
+    int val{};
+    assert(!queue.last_write_sequence());
+    assert(!queue.last_read_sequence());
+    for (int i{}; i < 20; ++i) {
+      queue.push(i);
+      assert(queue.last_write_sequence() == static_cast<std::uint64_t>(i + 1));
+      queue.pop(val);
+      assert(queue.last_read_sequence() == static_cast<std::uint64_t>(i + 1));
+    }
+    assert(!queue.dropped());
+    // Overrunning the reader loses a full lap and reports a gap
+    for (int i{}; i < size + 1; ++i) {
+      queue.force_push(i);
+    }
+    assert(queue.dropped() == size + 1);
+    assert(queue.monitor_snapshot().dropped_ == size + 1);
+    assert(queue.last_write_sequence() == 25);
+    queue.push(5);
+    const auto before = queue.last_read_sequence();
+    queue.pop(val);
+    assert(val == 5);
+    assert(queue.last_read_sequence() - before == size + 2);
+    assert(queue.last_read_sequence() == queue.last_write_sequence());
+  }
+
+  // Monitor Snapshot
+  {
+    const int size{2'048};
+    dro::SPSCQueue<int> queue{size};
+    int val{};
+    auto first = queue.monitor_snapshot();
+    assert(!first.size());
+    assert(!queue.try_pop(val));
+    for (int i{}; i < 1'500; ++i) {
+      queue.push(i);
+    }
+    auto second = queue.monitor_snapshot();
+    // Published every 1'024 writes, so the snapshot lags the true size
+    assert(second.writeSequence_ == 1'024);
+    assert(second.size() == 1'024);
+    assert(second.emptyStalls_ == 1);
+    assert(!second.fullStalls_);
+    assert(second.write_rate(first) > 0.0);
+    for (int i{}; i < 1'500; ++i) {
+      queue.pop(val);
+    }
+    assert(!queue.try_pop(val));
+    auto third = queue.monitor_snapshot();
+    assert(third.readSequence_ == 1'500);
+    assert(third.emptyStalls_ == 2);
+    assert(third.read_rate(second) > 0.0);
+  }
+
+  // Batched Pop With Deadline
+  {
+    const int size{16};
+    dro::SPSCQueue<int> queue{size};
+    std::vector<int> out;
+    auto deadline = [] {
+      return std::chrono::steady_clock::now() + std::chrono::milliseconds(1);
+    };
+    for (int i{}; i < 10; ++i) {
+      queue.push(i);
+    }
+    assert(queue.pop_n_wait(std::back_inserter(out), 4, 8, deadline()) == 8);
+    assert(queue.size() == 2);
+    // The deadline passes first, so the ready elements are returned
+    assert(queue.pop_n_wait(std::back_inserter(out), 5, 8, deadline()) == 2);
+    assert(!queue.pop_n_wait(std::back_inserter(out), 1, 8, deadline()));
+    for (int i{}; i < 10; ++i) {
+      assert(out[i] == i);
+    }
+    assert(queue.last_read_sequence() == 10);
+
+    // Watermark callbacks still fire when the batch crosses the low watermark
+    int lowCount{};
+    queue.set_watermarks(6, 2, nullptr, [&] { ++lowCount; });
+    for (int i{}; i < 8; ++i) {
+      queue.push(i);
+    }
+    out.clear();
+    assert(queue.pop_n_wait(std::back_inserter(out), 8, 16, deadline()) == 8);
+    assert(lowCount == 1);
+    assert(queue.empty());
+
+    // Waits for the producer to reach the minimum
+    const int iter{64};
+    auto thrd = std::thread([&] {
+      for (int i{}; i < iter; ++i) {
+        queue.push(i);
+      }
+    });
+    out.clear();
+    while (out.size() < iter) {
+      const auto minCount = std::min<std::size_t>(4, iter - out.size());
+      const auto count = queue.pop_n_wait(
+          std::back_inserter(out), minCount, 8,
+          std::chrono::steady_clock::now() + std::chrono::seconds(10));
+      assert(count >= minCount);
+    }
+    thrd.join();
+    for (int i{}; i < iter; ++i) {
+      assert(out[i] == i);
+    }
+  }
+
+  // Full Policy Traits
+  {
+    const int size{4};
+    dro::SPSCQueue<int, 0, std::allocator<int>, DropTraits> dropQueue{size};
+    dro::SPSCQueue<int, 0, std::allocator<int>, OverwriteTraits> overwriteQueue{
+        size};
+    int val{};
+    for (int i{}; i < size + 2; ++i) {
+      dropQueue.push(i);
+      overwriteQueue.push(i);
+    }
+    // Drop keeps the oldest elements, and stats are compiled out
+    assert(dropQueue.size() == size);
+    assert(dropQueue.try_pop(val));
+    assert(val == 0);
+    assert(!dropQueue.monitor_snapshot().fullStalls_);
+    // Overwrite overruns the reader as force_push does
+    assert(overwriteQueue.dropped() == size + 1);
+    assert(overwriteQueue.try_pop(val));
+    assert(val == size + 1);
+  }
+
+  // Drop Policy Loss Accounting
+  {
+    const int size{4};
+    dro::SPSCQueue<int, 0, std::allocator<int>, DropStatsTraits> queue{size};
+    int val{};
+    for (int i{}; i < size + 2; ++i) {
+      queue.push(i);
+    }
+    std::stop_source source;
+    assert(!queue.emplace(source.get_token(), size + 2));
+    assert(!queue.try_emplace(size + 3));
+    // Refused by the policy, not a failed try, so try_emplace is not counted
+    assert(queue.dropped() == 3);
+    assert(queue.monitor_snapshot().dropped_ == 3);
+    // Refused elements take sequence numbers
+    assert(queue.last_write_sequence() == size + 3);
+    for (int i{}; i < size; ++i) {
+      queue.pop(val);
+      assert(val == i);
+    }
+    queue.push(size + 3);
+    const auto before = queue.last_read_sequence();
+    queue.pop(val);
+    assert(val == size + 3);
+    // The consumer sees the gap left by the refused elements
+    assert(queue.last_read_sequence() - before == 4);
+    assert(queue.last_read_sequence() == queue.last_write_sequence());
+
+    // The gap is reported after the elements written before the refusal,
+    // even when the consumer has already seen later writes
+    dro::SPSCQueue<int, 0, std::allocator<int>, DropStatsTraits> gapQueue{
+        size};
+    for (int i{}; i < size; ++i) {
+      gapQueue.push(i);
+    }
+    gapQueue.pop(val);
+    gapQueue.push(size);
+    gapQueue.push(size + 1);
+    gapQueue.pop(val);
+    gapQueue.push(size + 2);
+    auto previous = gapQueue.last_read_sequence();
+    for (int i{2}; i <= size; ++i) {
+      gapQueue.pop(val);
+      assert(val == i);
+      assert(gapQueue.last_read_sequence() - previous == 1);
+      previous = gapQueue.last_read_sequence();
+    }
+    gapQueue.pop(val);
+    assert(val == size + 2);
+    assert(gapQueue.last_read_sequence() - previous == 2);
+    assert(gapQueue.last_read_sequence() == gapQueue.last_write_sequence());
+  }
+
+  // Batched Publication Traits
+  {
+    const int size{16};
+    dro::SPSCQueue<int, 0, std::allocator<int>, BatchTraits> queue{size};
+    int val{};
+    queue.push(1);
+    queue.push(2);
+    // Held back until the batch fills or the producer flushes
+    assert(!queue.try_pop(val));
+    assert(queue.last_write_sequence() == 2);
+    queue.flush();
+    assert(queue.try_pop(val));
+    assert(val == 1);
+    assert(queue.try_pop(val));
+    for (int i{}; i < 4; ++i) {
+      queue.push(i);
+    }
+    assert(queue.size() == 4);
+
+    // The producer publishes before waiting on a full queue
+    const int iter{1'000};
+    auto thrd = std::thread([&] {
+      for (int i{}; i < iter; ++i) {
+        queue.pop(val);
+        assert(val == i);
+      }
+    });
+    for (int i{4}; i < iter; ++i) {
+      queue.push(i);
+    }
+    queue.flush();
+    thrd.join();
+    assert(queue.empty());
+  }
+
+  // Adaptive Publication Traits
+  {
+    const int size{32};
+    dro::SPSCQueue<int, 0, std::allocator<int>, AdaptiveTraits> queue{size};
+    int val{};
+    // The consumer is caught up, so each write is published immediately
+    queue.push(0);
+    assert(queue.size() == 1);
+    // A burst leaves the consumer lagging, so writes are published in batches
+    for (int i{1}; i < 7; ++i) {
+      queue.push(i);
+    }
+    assert(queue.size() < 7);
+    queue.flush();
+    assert(queue.size() == 7);
+    while (queue.try_pop(val)) {
+    }
+    assert(val == 6);
+    // Returns to immediate publication within a batch of the consumer
+    // catching up
+    for (int i{}; i < 4; ++i) {
+      queue.push(i);
+      static_cast<void>(queue.try_pop(val));
+    }
+    queue.flush();
+    while (queue.try_pop(val)) {
+    }
+    for (int i{}; i < 3 * size; ++i) {
+      queue.push(i);
+      assert(queue.try_pop(val));
+      assert(val == i);
+    }
+  }
+
+  // Adaptive Spin Then Park Traits
+  {
+    const int size{4};
+    dro::SPSCQueue<int, 0, std::allocator<int>, ParkTraits> queue{size};
+    const int iter{200};
+    // The consumer parks on an empty queue and the producer on a full one
+    auto thrd = std::thread([&] {
+      for (int i{}; i < iter; ++i) {
+        if (i % 50 == 0) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        int val{};
+        queue.pop(val);
+        assert(val == i);
+      }
+    });
+    for (int i{}; i < iter; ++i) {
+      if (i % 40 == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      queue.push(i);
+    }
+    thrd.join();
+    assert(queue.empty());
+
+    // Woken only once the minimum is ready, or times out
+    std::vector<int> out;
+    thrd = std::thread([&] {
+      for (int i{}; i < 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        queue.push(i);
+      }
+    });
+    assert(queue.pop_n_wait(std::back_inserter(out), 3, 4,
+                            std::chrono::steady_clock::now() +
+                                std::chrono::seconds(10)) == 3);
+    thrd.join();
+    const auto start = std::chrono::steady_clock::now();
+    assert(!queue.pop_n_wait(std::back_inserter(out), 1, 4,
+                             start + std::chrono::milliseconds(2)));
+    assert(std::chrono::steady_clock::now() - start >=
+           std::chrono::milliseconds(2));
+  }
+
+  // Capacity Lower Bounds
+  {
+    dro::SPSCQueue<int> producerQueue(8);
+    assert(producerQueue.free_slots_lower_bound() == 8);
+    for (int i{}; i < 5; ++i) {
+      producerQueue.push(i);
+    }
+    assert(producerQueue.free_slots_lower_bound() == 3);
+    int discard{};
+    producerQueue.pop(discard);
+    producerQueue.pop(discard);
+    // The producer has not seen the reads yet
+    assert(producerQueue.free_slots_lower_bound() == 3);
+    assert(producerQueue.free_slots_lower_bound(true) == 5);
+
+    dro::SPSCQueue<int> queue(8);
+    assert(queue.available_lower_bound() == 0);
+    for (int i{}; i < 3; ++i) {
+      queue.push(i);
+    }
+    // Neither side has looked at the other's index yet
+    assert(queue.available_lower_bound() == 0);
+    assert(queue.available_lower_bound(true) == 3);
+    int val{};
+    queue.pop(val);
+    assert(queue.available_lower_bound() == 2);
+    queue.push(3);
+    queue.push(4);
+    assert(queue.available_lower_bound() == 2);
+    // Emptying the cached range refreshes the write index
+    for (int i{}; i < 3; ++i) {
+      queue.pop(val);
+    }
+    assert(val == 3);
+    assert(queue.available_lower_bound() == 1);
+    assert(queue.free_slots_lower_bound() == 3);
+    assert(queue.free_slots_lower_bound(true) == 7);
+    assert(queue.size() == 1);
+  }
+
+  // Skip To Latest
+  {
+    dro::SPSCQueue<int> queue(8);
+    assert(queue.skip_to_latest(2) == 0);
+    for (int i{}; i < 7; ++i) {
+      queue.push(i);
+    }
+    int val{};
+    queue.pop(val);
+    assert(queue.skip_to_latest(2) == 4);
+    assert(queue.size() == 2);
+    assert(queue.skip_to_latest(2) == 0);
+    // The read index wraps across the end of the buffer
+    for (int i{7}; i < 12; ++i) {
+      queue.push(i);
+    }
+    assert(queue.skip_to_latest(3) == 4);
+    for (int i{9}; i < 12; ++i) {
+      queue.pop(val);
+      assert(val == i);
+    }
+    for (int i{12}; i < 15; ++i) {
+      queue.push(i);
+    }
+    assert(queue.clear() == 3);
+    assert(queue.empty());
+    assert(!queue.try_pop(val));
+
+    // Skipping past a low watermark limit keeps the callbacks working
+    dro::SPSCQueue<int> watermarked(8);
+    int highCount{};
+    int lowCount{};
+    watermarked.set_watermarks(
+        6, 2, [&] { ++highCount; }, [&] { ++lowCount; });
+    for (int i{}; i < 7; ++i) {
+      watermarked.push(i);
+    }
+    assert(highCount == 1);
+    watermarked.pop(val);
+    assert(watermarked.skip_to_latest(1) == 5);
+    assert(lowCount == 1);
+    watermarked.pop(val);
+    assert(val == 6);
+    assert(!watermarked.try_pop(val));
+  }
+
+  // Zero Copy Peek
+  {
+    dro::SPSCQueue<std::unique_ptr<int>> queue(2);
+    assert(queue.front() == nullptr);
+    queue.push(std::make_unique<int>(1));
+    queue.push(std::make_unique<int>(2));
+    for (int i{1}; i <= 2; ++i) {
+      auto *head = queue.front();
+      assert(head && **head == i);
+      // Peeking twice returns the same element
+      assert(queue.front() == head);
+      queue.pop();
+    }
+    assert(queue.front() == nullptr);
+    assert(queue.empty());
+  }
+
+  // Zero Copy Claim
+  {
+    dro::SPSCQueue<std::vector<int>> queue(2);
+    for (int i{}; i < 2; ++i) {
+      auto *slot = queue.claim();
+      assert(slot);
+      slot->assign(3, i);
+      queue.commit();
+    }
+    assert(queue.claim() == nullptr);
+    auto *head = queue.front();
+    assert(head && head->size() == 3 && head->front() == 0);
+    queue.pop();
+    auto *slot = queue.claim();
+    assert(slot && slot->empty());
+    queue.commit();
+    assert(queue.size() == 2);
+  }
+
+  // Initialize Slots
+  {
+    dro::SPSCQueue<std::vector<int>> queue(2);
+    std::size_t visited{};
+    queue.initialize_slots([&](std::vector<int> &slot) {
+      slot.reserve(16);
+      ++visited;
+    });
+    // Includes the slot kept free to tell a full queue from an empty one
+    assert(visited == 3);
+    assert(queue.empty());
+    assert(!queue.last_write_sequence() && !queue.last_read_sequence());
+    assert(!queue.monitor_snapshot().writeSequence_);
+    for (int i{}; i < 3; ++i) {
+      auto *slot = queue.claim();
+      assert(slot && slot->capacity() >= 16);
+      queue.commit();
+      queue.pop();
+    }
+  }
+
+  // Consumption Tickets
+  {
+    // Tickets stay ordered across many laps of a small queue
+    dro::SPSCQueue<int> queue(2);
+    int val{};
+    for (int i{}; i < 10; ++i) {
+      const auto first = queue.emplace_ticket(i);
+      const auto second = queue.emplace_ticket(i);
+      assert(second == first + 1 && second == queue.last_write_sequence());
+      assert(!queue.is_consumed(first) && !queue.is_consumed(second));
+      queue.pop(val);
+      assert(queue.is_consumed(first) && !queue.is_consumed(second));
+      queue.pop(val);
+      assert(queue.is_consumed(second));
+      queue.wait_until_consumed(second);
+    }
+
+    // A dropped element gets no ticket rather than the previous one
+    dro::SPSCQueue<int, 0, std::allocator<int>, DropTraits> dropQueue(2);
+    const auto first = dropQueue.emplace_ticket(1);
+    const auto second = dropQueue.emplace_ticket(2);
+    assert(first == 1 && second == 2);
+    assert(dropQueue.emplace_ticket(3) == 0);
+    dropQueue.pop(val);
+    assert(dropQueue.is_consumed(first) && !dropQueue.is_consumed(second));
+    // The dropped element took sequence 3
+    const auto third = dropQueue.emplace_ticket(3);
+    assert(third == 4);
+    dropQueue.pop(val);
+    assert(dropQueue.is_consumed(second) && !dropQueue.is_consumed(third));
+    dropQueue.pop(val);
+    assert(dropQueue.is_consumed(third));
+
+    // The consumer releases each element only after processing it
+    auto processAll = [](auto &queue) {
+      // Not a multiple of the publish batch, so the last writes are pending
+      const int count{203};
+      std::atomic<int> processed{0};
+      auto thrd = std::thread([&] {
+        for (int i{}; i < count; ++i) {
+          auto *head = queue.front();
+          while (!head) {
+            head = queue.front();
+          }
+          if (i % 50 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+          processed.fetch_add(1, std::memory_order_relaxed);
+          queue.pop();
+        }
+      });
+      std::uint64_t ticket{};
+      for (int i{}; i < count; ++i) {
+        ticket = queue.emplace_ticket(i);
+      }
+      queue.wait_until_consumed(ticket);
+      assert(processed.load(std::memory_order_relaxed) == count);
+      thrd.join();
+    };
+    dro::SPSCQueue<int, 0, std::allocator<int>, ParkTraits> parkQueue(16);
+    processAll(parkQueue);
+    // Unpublished writes are flushed before waiting
+    dro::SPSCQueue<int, 0, std::allocator<int>, BatchTraits> batchQueue(16);
+    processAll(batchQueue);
+  }
+
+  // Stop Token
+  {
+    auto stopWaits = [](auto &queue) {
+      // A consumer blocked on an empty queue returns once stop is requested
+      std::atomic<bool> popped{true};
+      {
+        std::jthread consumer([&](std::stop_token token) {
+          int val{};
+          popped = queue.pop(val, token);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+      assert(!popped);
+
+      // As does a producer blocked on a full queue
+      assert(queue.emplace(std::stop_token{}, 1));
+      assert(queue.emplace(std::stop_token{}, 2));
+      std::atomic<bool> pushed{true};
+      {
+        std::jthread producer([&](std::stop_token token) {
+          pushed = queue.emplace(token, 3);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+      assert(!pushed);
+
+      // Ready elements are still popped after stop is requested
+      std::stop_source source;
+      source.request_stop();
+      int val{};
+      assert(queue.pop(val, source.get_token()) && val == 1);
+      assert(queue.pop(val, source.get_token()) && val == 2);
+      assert(!queue.pop(val, source.get_token()));
+    };
+    dro::SPSCQueue<int> spinQueue(2);
+    stopWaits(spinQueue);
+    dro::SPSCQueue<int, 0, std::allocator<int>, ParkTraits> parkQueue(2);
+    stopWaits(parkQueue);
+  }
+
   // Constructor Exception
   {
     try {
@@ -0,0 +1,61 @@
+// Copyright (c) 2024 Andrew Drogalis
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the “Software”), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+
+#include <chrono>    // for seconds
+#include <cstdio>    // for printf, fflush
+#include <map>       // for std::map
+#include <stdexcept> // for invalid_argument
+#include <string>    // for stoi, basic_string
+#include <thread>    // for sleep_for
+
+#include "dro/metrics-registry.hpp" // for dro::MetricsReader
+
+// Usage: spsc-top <shared memory name> [refresh count]
+int main(int argc, char *argv[]) {
+  if (argc != 2 && argc != 3) {
+    throw std::invalid_argument(
+        "Provide the shared memory name and an optional refresh count.");
+  }
+  const int refreshCount{(argc == 3) ? std::stoi(argv[2]) : -1};
+
+  // Attaches read only, the monitored process is never written to
+  dro::MetricsReader reader(argv[1]);
+  std::map<std::string, dro::MonitorSnapshot> previous;
+
+  for (int i{}; i != refreshCount; ++i) {
+    // Clears the terminal and moves the cursor home
+    std::printf("\033[2J\033[H");
+    std::printf("%-32s %12s %12s %14s %14s %12s %12s %12s\n", "QUEUE",
+                "CAPACITY", "DEPTH", "WRITES/S", "READS/S", "FULL", "EMPTY",
+                "DROPPED");
+    reader.for_each([&](const dro::MetricsReader::QueueMetrics &metrics) {
+      const auto &snapshot = metrics.snapshot_;
+      auto it = previous.find(metrics.name_);
+      const double writeRate =
+          (it != previous.end()) ? snapshot.write_rate(it->second) : 0.0;
+      const double readRate =
+          (it != previous.end()) ? snapshot.read_rate(it->second) : 0.0;
+      std::printf("%-32s %12llu %12zu %14.0f %14.0f %12llu %12llu %12llu\n",
+                  metrics.name_.c_str(),
+                  static_cast<unsigned long long>(metrics.capacity_),
+                  snapshot.size(), writeRate, readRate,
+                  static_cast<unsigned long long>(snapshot.fullStalls_),
+                  static_cast<unsigned long long>(snapshot.emptyStalls_),
+                  static_cast<unsigned long long>(snapshot.dropped_));
+      previous[metrics.name_] = snapshot;
+    });
+    std::fflush(stdout);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+
+  return 0;
+}